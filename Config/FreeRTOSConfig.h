@@ -10,7 +10,11 @@ extern uint32_t SystemCoreClock;
 
 #define configUSE_PREEMPTION                    1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#ifdef SBT_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                 1
+#else
 #define configUSE_TICKLESS_IDLE                 0
+#endif
 #define configCPU_CLOCK_HZ                      (SystemCoreClock)
 //#define configSYSTICK_CLOCK_HZ 1000000
 #define configTICK_RATE_HZ                      1000
@@ -19,7 +23,7 @@ extern uint32_t SystemCoreClock;
 #define configMAX_TASK_NAME_LEN                 16
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
-#define configUSE_TASK_NOTIFICATIONS            0
+#define configUSE_TASK_NOTIFICATIONS            1
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES   3
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
@@ -35,16 +39,34 @@ extern uint32_t SystemCoreClock;
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
+// With SBT_STATIC_ALLOCATION system tasks and the idle task are allocated
+// statically (see StaticTask.hpp)
+#ifdef SBT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION         1
+#else
 #define configSUPPORT_STATIC_ALLOCATION         0
+#endif
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 #ifndef configTOTAL_HEAP_SIZE
 #define configTOTAL_HEAP_SIZE 15360
 #endif
 #define configAPPLICATION_ALLOCATED_HEAP 1
+// Global operator new and delete use this heap too (see Heap.hpp). With
+// SBT_HEAP_FREEZE every allocation is checked against the freeze.
+#ifdef SBT_HEAP_FREEZE
+void vHeapAllocated(size_t xSize);
+#define traceMALLOC(pvAddress, uiSize) vHeapAllocated(uiSize)
+#endif
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK              1
+// With SBT_TASK_SUPERVISOR the tick hook refreshes the watchdog instead of
+// the idle hook (see TaskSupervisor.hpp)
+#ifdef SBT_TASK_SUPERVISOR
+#define configUSE_TICK_HOOK              1
+#else
 #define configUSE_TICK_HOOK              0
+#endif
 
 #ifdef SBT_DEBUG
 #define configCHECK_FOR_STACK_OVERFLOW 2
@@ -56,11 +78,39 @@ extern uint32_t SystemCoreClock;
 
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
+/* Low power related definitions. */
+// With SBT_TICKLESS_IDLE the port's default vPortSuppressTicksAndSleep() is
+// used, sleeps are limited by the watchdog and the HAL tick is stepped with
+// the kernel tick (see LowPower.hpp)
+#ifdef SBT_TICKLESS_IDLE
+void vPortSuppressTicksAndSleep(uint32_t xExpectedIdleTime);
+uint32_t ulLimitIdleTime(uint32_t xExpectedIdleTime);
+void vPreSleepProcessing(uint32_t xExpectedIdleTime);
+void vPostSleepProcessing(uint32_t xExpectedIdleTime);
+void vTickStepped(uint32_t xTicksToJump);
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime)                        \
+    vPortSuppressTicksAndSleep(ulLimitIdleTime(xExpectedIdleTime))
+#define configPRE_SLEEP_PROCESSING(x)  vPreSleepProcessing(x)
+#define configPOST_SLEEP_PROCESSING(x) vPostSleepProcessing(x)
+#define traceINCREASE_TICK_COUNT(x)    vTickStepped(x)
+#endif
+
 void vApplicationMallocFailedHook(void);
 
 /* Run time and task stats gathering related definitions. */
+// With SBT_RUNTIME_STATS the run time counter is DWT CYCCNT (see
+// CycleCounter.hpp and RuntimeStats.hpp), a single load per context switch
+#ifdef SBT_RUNTIME_STATS
+#define configGENERATE_RUN_TIME_STATS        1
+#define configUSE_TRACE_FACILITY             1
+void vConfigureTimerForRunTimeStats(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()                               \
+    vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE() (*(volatile uint32_t*)0xE0001004UL)
+#else
 #define configGENERATE_RUN_TIME_STATS        0
 #define configUSE_TRACE_FACILITY             0
+#endif
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
 
 /* Co-routine related definitions. */
@@ -120,8 +170,16 @@ void vAssertCalled(const char* fileName, const int lineNumber);
 #define INCLUDE_vTaskDelay                                     1
 #define INCLUDE_xTaskGetSchedulerState                         1
 #define INCLUDE_xTaskGetCurrentTaskHandle                      1
+#ifdef SBT_STACK_MONITOR
+#define INCLUDE_uxTaskGetStackHighWaterMark                    1
+#else
 #define INCLUDE_uxTaskGetStackHighWaterMark                    0
+#endif
+#ifdef SBT_RUNTIME_STATS
+#define INCLUDE_xTaskGetIdleTaskHandle                         1
+#else
 #define INCLUDE_xTaskGetIdleTaskHandle                         0
+#endif
 #define INCLUDE_eTaskGetState                                  0
 #define INCLUDE_xEventGroupSetBitFromISR                       1
 #define INCLUDE_xTimerPendFunctionCall                         0
@@ -3,49 +3,66 @@
 //
 
 #include "Error.hpp"
+#include "ErrorLog.hpp"
 #include <FreeRTOS.h>
+#include <stm32f1xx_hal.h>
 #include <task.h>
 
-void softfault([[maybe_unused]] const std::string& fileName,
-               [[maybe_unused]] const int& lineNumber,
-               [[maybe_unused]] const std::string& comment)
+using namespace SBT::System;
+
+[[noreturn]] static void stop()
 {
-    // A software error occurred
-    taskDISABLE_INTERRUPTS();
+#ifdef SBT_ERROR_RESET
+    NVIC_SystemReset();
+#endif
     while(true)
         ;
 }
 
-void softfault([[maybe_unused]] const std::string& comment)
+[[noreturn]] static void fault(const Error& error)
 {
-    // A software error occurred. See call stack to find out where it happened.
     taskDISABLE_INTERRUPTS();
-    while(true)
-        ;
+    ErrorLog::Append(error);
+    stop();
 }
 
-void vAssertCalled([[maybe_unused]] const char* fileName,
-                   [[maybe_unused]] const int lineNumber)
+void softfault(const Error& error)
+{
+    // A software error occurred. See call stack to find out where it happened.
+    fault(error);
+}
+
+void softfault(const char* fileName, int lineNumber,
+               [[maybe_unused]] const char* comment)
+{
+    // A software error occurred
+    fault({ErrorModule::Application, ErrorCode::Message,
+           static_cast<uint16_t>(lineNumber),
+           static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fileName))});
+}
+
+void vAssertCalled(const char* fileName, const int lineNumber)
 {
     // FreeRTOS assertion failed
-    taskDISABLE_INTERRUPTS();
-    while(true)
-        ;
+    fault({ErrorModule::FreeRTOS, ErrorCode::AssertFailed,
+           static_cast<uint16_t>(lineNumber),
+           static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fileName))});
 }
 
 void vApplicationMallocFailedHook()
 {
     // Memory allocation failed. See call stack to find out where it happened.
-    taskDISABLE_INTERRUPTS();
-    while(true)
-        ;
+    fault({ErrorModule::FreeRTOS, ErrorCode::MallocFailed, 0,
+           static_cast<uint32_t>(xPortGetFreeHeapSize())});
 }
 
 void vApplicationStackOverflowHook([[maybe_unused]] TaskHandle_t xTask,
-                                   [[maybe_unused]] char* pcTaskName)
+                                   char* pcTaskName)
 {
     // Task of name 'pcTaskName' caused stack overflow
-    taskDISABLE_INTERRUPTS();
-    while(true)
-        ;
+    uint32_t name = 0;
+    for(unsigned i = 0; i < 4 && pcTaskName[i] != '\0'; i++)
+        name |= static_cast<uint32_t>(static_cast<uint8_t>(pcTaskName[i]))
+                << (8 * i);
+    fault({ErrorModule::FreeRTOS, ErrorCode::StackOverflow, 0, name});
 }
@@ -5,11 +5,100 @@
 #ifndef F1XX_PROJECT_TEMPLATE_ERROR_HPP
 #define F1XX_PROJECT_TEMPLATE_ERROR_HPP
 
-#include <string>
+#include <cstdint>
 
-void softfault(const std::string& fileName, const int& lineNumber,
-               const std::string& comment);
+// Action taken after an error is logged (see ErrorLog.hpp). SBT_ERROR_HALT
+// spins with interrupts disabled - for a debugger, or until the watchdog
+// resets the node. SBT_ERROR_RESET resets the node at once. Default is halt
+// with SBT_DEBUG and reset otherwise.
+#if !defined(SBT_ERROR_HALT) && !defined(SBT_ERROR_RESET)
+#ifdef SBT_DEBUG
+#define SBT_ERROR_HALT
+#else
+#define SBT_ERROR_RESET
+#endif
+#endif
 
-void softfault(const std::string& comment);
+namespace SBT::System {
+
+// Module which reported an error
+enum class ErrorModule : uint8_t {
+    Application,
+    System,
+    FreeRTOS,
+    Hardware,
+    GPIO,
+    ADC,
+    DMA,
+    CAN,
+    UART,
+    SPI,
+    I2C,
+    CommCAN,
+    CallbackRegistry,
+    TaskManager,
+    JobScheduler,
+    Coroutine,
+    RuntimeStats,
+    Schedulability,
+    Heap,
+    BlockPool,
+    Counters
+};
+
+// Meaning of the error's argument is given next to the code
+enum class ErrorCode : uint8_t {
+    Unknown,
+    // softfault() with a message, address of the file name
+    Message,
+    // HAL status
+    HalFailure,
+    NotInitialized,
+    AlreadyInitialized,
+    NotStarted,
+    AlreadyStarted,
+    NotImplemented,
+    // Peripheral, port or index does not exist
+    InvalidInstance,
+    // Rejected value
+    InvalidArgument,
+    InvalidState,
+    AlreadyExists,
+    DoesNotExist,
+    CapacityExceeded,
+    CreateFailed,
+    Unschedulable,
+    // configASSERT failed, address of the file name
+    AssertFailed,
+    // Free heap size
+    MallocFailed,
+    // First four characters of the task name
+    StackOverflow,
+    // HardFault, MemManage, BusFault or UsageFault (see CrashDump.hpp), PC
+    Fault
+};
+
+// Compact error record, 8 bytes. Module, code and line are constants at the
+// reporting site, so reporting does not allocate or format text.
+struct Error {
+    ErrorModule module;
+    ErrorCode code;
+    uint16_t line;
+    uint32_t argument;
+};
+
+} // namespace SBT::System
+
+/**
+ * @brief Log the error to the persistent error log, then halt or reset (see
+ * SBT_ERROR_HALT). Safe in interrupts and with the heap exhausted.
+ * @example softfault({ErrorModule::CAN, ErrorCode::NotStarted, __LINE__, 0});
+ */
+[[noreturn]] void softfault(const SBT::System::Error& error);
+
+// Application error with a message. The message is not logged - the record
+// keeps the line and the address of the file name.
+[[noreturn]] void softfault(const char* fileName, int lineNumber,
+                            const char* comment);
 
 #endif // F1XX_PROJECT_TEMPLATE_ERROR_HPP
@@ -5,35 +5,39 @@
 #include "ADC.hpp"
 #include "Error.hpp"
 
-static void adcError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void adcError(ErrorCode code, uint32_t argument = 0,
+                     uint16_t line = __builtin_LINE())
 {
-    softfault("ADC: " + comment);
+    softfault({SBT::System::ErrorModule::ADC, code, line, argument});
 }
 
-static void adcErrorConvNotImpl() { adcError("Converter is not implemented"); }
-
-static void adcErrorConvNotInit() { adcError("Converter is not initialized"); }
-
-static void adcHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void adcErrorConvNotImpl(uint16_t line = __builtin_LINE())
 {
-    if(halStatus != HAL_OK)
-        adcError("HAL function failed with code " + std::to_string(halStatus));
+    adcError(ErrorCode::NotImplemented, 0, line);
 }
 
-namespace SBT::Hardware {
-ADC::ADCChannel::ADCChannel(const Channel channel)
-    : channel(channel), config(new ADC_ChannelConfTypeDef)
+static void adcErrorConvNotInit(uint16_t line = __builtin_LINE())
 {
+    adcError(ErrorCode::NotInitialized, 0, line);
 }
 
-ADC::ADCChannel::~ADCChannel() { delete config; }
+static void adcHALErrorGuard(HAL_StatusTypeDef halStatus,
+                             uint16_t line = __builtin_LINE())
+{
+    if(halStatus != HAL_OK)
+        adcError(ErrorCode::HalFailure, halStatus, line);
+}
 
-ADC::ADC(ADC_TypeDef* const adc) : handle(new ADC_HandleTypeDef)
+namespace SBT::Hardware {
+ADC::ADC(ADC_TypeDef* const adc)
 {
-    handle->Instance = adc;
+    slots.fill(NoSlot);
+    handle.Instance = adc;
 
     // Select DMA controller and channel
-    if(handle->Instance == ADC1) {
+    if(handle.Instance == ADC1) {
         dmaController = &dma1;
         dmaChannel = DMA::Channel::Channel1;
     }
@@ -41,17 +45,17 @@ ADC::ADC(ADC_TypeDef* const adc) : handle(new ADC_HandleTypeDef)
         adcErrorConvNotImpl();
 
     // Set defaults
-    handle->Init.DataAlign = static_cast<uint32_t>(DataAlignment::Right);
-    handle->Init.ScanConvMode = ADC_SCAN_ENABLE;
-    handle->Init.ContinuousConvMode = ENABLE;
-    handle->Init.NbrOfConversion = 0;
-    handle->Init.DiscontinuousConvMode = DISABLE;
-    handle->Init.ExternalTrigConv = ADC_SOFTWARE_START;
+    handle.Init.DataAlign = static_cast<uint32_t>(DataAlignment::Right);
+    handle.Init.ScanConvMode = ADC_SCAN_ENABLE;
+    handle.Init.ContinuousConvMode = ENABLE;
+    handle.Init.NbrOfConversion = 0;
+    handle.Init.DiscontinuousConvMode = DISABLE;
+    handle.Init.ExternalTrigConv = ADC_SOFTWARE_START;
 }
 
 IRQn_Type ADC::GetConverterIRQ()
 {
-    if(handle->Instance == ADC1)
+    if(handle.Instance == ADC1)
         return ADC1_2_IRQn;
     else
         adcErrorConvNotImpl();
@@ -59,39 +63,33 @@ IRQn_Type ADC::GetConverterIRQ()
     return static_cast<IRQn_Type>(0);
 }
 
-ADC::ADCChannel* ADC::GetChannelObjectNoError(const Channel channel)
+uint8_t ADC::GetChannelSlot(const Channel channel)
 {
-    for(auto i : channels)
-        if(i->channel == channel)
-            return i;
-    return nullptr;
-}
-
-ADC::ADCChannel* ADC::GetChannelObject(const Channel channel)
-{
-    ADCChannel* chn = GetChannelObjectNoError(channel);
-    if(chn == nullptr)
-        adcError("Channel does not exist");
-    return chn;
+    const uint8_t slot = slots[static_cast<size_t>(channel)];
+    if(slot == NoSlot)
+        adcError(ErrorCode::DoesNotExist, static_cast<uint32_t>(channel));
+    return slot;
 }
 
 void ADC::SetConverterDataAlignment(const DataAlignment dataAlignment)
 {
-    handle->Init.DataAlign = static_cast<uint32_t>(dataAlignment);
+    handle.Init.DataAlign = static_cast<uint32_t>(dataAlignment);
 }
 
 void ADC::InitConverter()
 {
     if(inited)
-        adcError("Converter is already initialized");
+        adcError(ErrorCode::AlreadyInitialized);
 
-    if(handle->Instance == ADC1)
+    if(handle.Instance == ADC1)
         __HAL_RCC_ADC1_CLK_ENABLE();
     else
         adcErrorConvNotImpl();
 
-    if(HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_ADC) > 14e6)
-        adcError("Clock frequency is too high (maximum is 14MHz)");
+    // Maximum ADC clock frequency is 14 MHz
+    const uint32_t clock = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_ADC);
+    if(clock > 14e6)
+        adcError(ErrorCode::InvalidArgument, clock);
 
     // Set up DMA
     dmaController->InitController();
@@ -102,8 +100,8 @@ void ADC::InitConverter()
     dmaController->SetChannelMemDataAlignment(dmaChannel,
                                               DMA::MemDataAlignment::HalfWord);
     dmaController->SetChannelMode(dmaChannel, DMA::Mode::Circular);
-    handle->DMA_Handle = dmaController->InitChannel(dmaChannel);
-    handle->DMA_Handle->Parent = handle;
+    handle.DMA_Handle = dmaController->InitChannel(dmaChannel);
+    handle.DMA_Handle->Parent = &handle;
 
     inited = true;
 }
@@ -115,6 +113,9 @@ void ADC::DeInitConverter()
     if(!inited)
         adcErrorConvNotInit();
 
+    if(running)
+        adcHALErrorGuard(HAL_ADC_Stop_DMA(&handle));
+    running = false;
     inited = false;
 
     // Deinitialize DMA
@@ -122,7 +123,7 @@ void ADC::DeInitConverter()
 
     // Do not deinitialize the controller as it may be in use by another device
 
-    if(handle->Instance == ADC1)
+    if(handle.Instance == ADC1)
         __HAL_RCC_ADC1_CLK_DISABLE();
     else
         adcErrorConvNotImpl();
@@ -130,39 +131,55 @@ void ADC::DeInitConverter()
 
 void ADC::CreateChannel(const Channel channel)
 {
-    ADCChannel* chn = GetChannelObjectNoError(channel);
-    if(chn != nullptr)
-        adcError("Channel already exists");
+    if(DoesChannelExist(channel))
+        adcError(ErrorCode::AlreadyExists, static_cast<uint32_t>(channel));
+    if(handle.Init.NbrOfConversion >= MaxConversions)
+        adcError(ErrorCode::CapacityExceeded, static_cast<uint32_t>(channel));
 
-    chn = new ADCChannel(channel);
-    chn->config->Channel = static_cast<uint32_t>(channel);
+    const uint8_t slot = handle.Init.NbrOfConversion++;
+    ADC_ChannelConfTypeDef& config = channels[slot];
+    config = {};
+    config.Channel = static_cast<uint32_t>(channel);
 
     // Set default value
-    chn->config->SamplingTime = static_cast<uint32_t>(SamplingTime::ST_239_5);
+    config.SamplingTime = static_cast<uint32_t>(SamplingTime::ST_239_5);
 
-    channels.push_front(chn);
-
-    if(++handle->Init.NbrOfConversion > 16)
-        adcError("A maximum of 16 channels is supported");
+    slots[static_cast<size_t>(channel)] = slot;
 }
 
 bool ADC::DoesChannelExist(Channel channel)
 {
-    return GetChannelObjectNoError(channel) != nullptr;
+    return slots[static_cast<size_t>(channel)] != NoSlot;
 }
 
 void ADC::DeleteChannel(Channel channel)
 {
-    ADCChannel* chn = GetChannelObject(channel);
-    --handle->Init.NbrOfConversion;
-    channels.remove(chn);
-    delete chn;
+    const uint8_t slot = GetChannelSlot(channel);
+    slots[static_cast<size_t>(channel)] = NoSlot;
+
+    // DMA writes readings by rank, so it has to stop before ranks change
+    const bool restart = running;
+    if(running) {
+        adcHALErrorGuard(HAL_ADC_Stop_DMA(&handle));
+        running = false;
+    }
+
+    // Move the last channel to the freed slot to keep slots contiguous
+    const uint8_t last = --handle.Init.NbrOfConversion;
+    if(slot != last) {
+        channels[slot] = channels[last];
+        values[slot] = values[last];
+        slots[channels[slot].Channel] = slot;
+    }
+
+    if(restart && handle.Init.NbrOfConversion != 0)
+        InitChannels();
 }
 
 void ADC::SetChannelSamplingTime(const Channel channel,
                                  const SamplingTime samplingTime)
 {
-    GetChannelObject(channel)->config->SamplingTime =
+    channels[GetChannelSlot(channel)].SamplingTime =
         static_cast<uint32_t>(samplingTime);
 }
 
@@ -170,38 +187,30 @@ void ADC::InitChannels()
 {
     if(!inited)
         adcErrorConvNotInit();
-    if(handle->Init.NbrOfConversion == 0)
-        adcError("No channels exist");
-    adcHALErrorGuard(HAL_ADC_Stop_DMA(handle));
-
-    // (Re)allocate value storage
-    delete values;
-    values = new uint16_t[handle->Init.NbrOfConversion];
-
-    // Configure channels
-    {
-        unsigned c = 0;
-        for(auto i : channels) {
-            i->config->Rank = c + 1;
-            i->value = &values[c];
-            adcHALErrorGuard(HAL_ADC_ConfigChannel(handle, i->config));
-            c++;
-        }
+    if(handle.Init.NbrOfConversion == 0)
+        adcError(ErrorCode::InvalidState);
+    adcHALErrorGuard(HAL_ADC_Stop_DMA(&handle));
+
+    // Configure channels, rank of a channel is its slot + 1
+    for(unsigned c = 0; c < handle.Init.NbrOfConversion; c++) {
+        channels[c].Rank = c + 1;
+        adcHALErrorGuard(HAL_ADC_ConfigChannel(&handle, &channels[c]));
     }
 
-    adcHALErrorGuard(HAL_ADC_Init(handle));
-    adcHALErrorGuard(HAL_ADCEx_Calibration_Start(handle));
-    adcHALErrorGuard(HAL_ADC_Start_DMA(handle,
-                                       reinterpret_cast<uint32_t*>(values),
-                                       handle->Init.NbrOfConversion));
+    adcHALErrorGuard(HAL_ADC_Init(&handle));
+    adcHALErrorGuard(HAL_ADCEx_Calibration_Start(&handle));
+    adcHALErrorGuard(
+        HAL_ADC_Start_DMA(&handle, reinterpret_cast<uint32_t*>(values.data()),
+                          handle.Init.NbrOfConversion));
+    running = true;
 }
 
 uint16_t ADC::GetChannelValue(const Channel channel)
 {
-    return *GetChannelObject(channel)->value;
+    return values[GetChannelSlot(channel)];
 }
 
-ADC_HandleTypeDef* ADC::GetConverterHandle() { return handle; }
+ADC_HandleTypeDef* ADC::GetConverterHandle() { return &handle; }
 
 ADC adc1(ADC1);
 } // namespace SBT::Hardware
@@ -6,7 +6,7 @@
 #define F1XX_PROJECT_TEMPLATE_ADC_HPP
 
 #include "DMA.hpp"
-#include <forward_list>
+#include <array>
 #include <stm32f1xx_hal.h>
 
 // How to use this driver:
@@ -64,33 +64,28 @@ public:
     };
 
 private:
-    class ADCChannel {
-        friend ADC;
-
-    private:
-        const Channel channel;
-        ADC_ChannelConfTypeDef* const config;
-        const uint16_t* value = nullptr;
-
-        explicit ADCChannel(Channel);
-        ~ADCChannel();
-
-    public:
-        ADCChannel() = delete;
-        ADCChannel(ADCChannel&) = delete;
-    };
-
-    std::forward_list<ADCChannel*> channels;
-    ADC_HandleTypeDef* const handle;
-    uint16_t* values = nullptr;
+    // Regular sequence length of the converter
+    static constexpr size_t MaxConversions = 16;
+    static constexpr size_t ChannelCount = 18;
+    static constexpr uint8_t NoSlot = 0xFF;
+
+    // Created channels occupy slots 0..NbrOfConversion-1, a slot is the
+    // channel's rank - 1 and index of its reading in values
+    std::array<ADC_ChannelConfTypeDef, MaxConversions> channels{};
+    // Slot of every channel or NoSlot, indexed by channel number
+    std::array<uint8_t, ChannelCount> slots;
+    // Readings written by DMA in circular mode
+    std::array<uint16_t, MaxConversions> values{};
+    ADC_HandleTypeDef handle{};
     bool inited = false;
+    // Conversions started by InitChannels()
+    bool running = false;
 
     DMA* dmaController;
     DMA::Channel dmaChannel;
 
     IRQn_Type GetConverterIRQ();
-    ADCChannel* GetChannelObjectNoError(Channel);
-    ADCChannel* GetChannelObject(Channel);
+    uint8_t GetChannelSlot(Channel);
 
 public:
     ADC() = delete;
@@ -121,6 +116,8 @@ public:
     bool DoesChannelExist(Channel);
 
     /// Delete an ADC channel
+    /// If conversions are running, they are stopped and the remaining
+    /// channels are reinitialized, so their readings stay correct
     void DeleteChannel(Channel);
 
     // Set channel parameters
@@ -4,31 +4,49 @@
 #include <optional>
 
 #include "CAN.hpp"
+#include "CallbackRegistry.hpp"
+#include "Counters.hpp"
 #include "Error.hpp"
 #include "GPIO.hpp"
 #include "Hardware.hpp"
 
-static void canError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void canError(ErrorCode code, uint32_t argument = 0,
+                     uint16_t line = __builtin_LINE())
 {
-    softfault("CAN: " + comment);
+    softfault({SBT::System::ErrorModule::CAN, code, line, argument});
 }
 
-static void canErrorNotInit() { canError("Not initialized"); }
+static void canErrorNotInit(uint16_t line = __builtin_LINE())
+{
+    canError(ErrorCode::NotInitialized, 0, line);
+}
 
-static void canErrorNotStarted() { canError("Not started"); }
+static void canErrorNotStarted(uint16_t line = __builtin_LINE())
+{
+    canError(ErrorCode::NotStarted, 0, line);
+}
 
-static void canErrorAlreadyInit() { canError("Already initialized"); }
+static void canErrorAlreadyInit(uint16_t line = __builtin_LINE())
+{
+    canError(ErrorCode::AlreadyInitialized, 0, line);
+}
 
-static void canErrorAlreadyStarted() { canError("Already started"); }
+static void canErrorAlreadyStarted(uint16_t line = __builtin_LINE())
+{
+    canError(ErrorCode::AlreadyStarted, 0, line);
+}
 
-static void canHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void canHALErrorGuard(HAL_StatusTypeDef halStatus,
+                             uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        canError("HAL function failed with code " + std::to_string(halStatus));
+        canError(ErrorCode::HalFailure, halStatus, line);
 }
 
 #define CAN_ACTIVE_NOTIFICATION(hcan, callbackType)                            \
-    if(callbackFunctions.count(callbackType))                                  \
+    if(callbackFunctions.IsSet(0, callbackType))                               \
         canHALErrorGuard(HAL_CAN_ActivateNotification(                         \
             hcan, static_cast<HAL_CAN_CallbackIDTypeDef>(callbackType)));
 
@@ -43,19 +61,28 @@ static void canHALErrorGuard(HAL_StatusTypeDef halStatus)
 
 namespace SBT::Hardware {
 
-// Unordered map containing callback functions for each callback type
-static std::unordered_map<hCAN::CallbackType, std::function<void()>>
+// Callback functions for each callback type of the single CAN. MspDeInit has
+// the highest HAL callback ID.
+static CallbackRegistry<hCAN::CallbackType, 1,
+                        static_cast<size_t>(hCAN::CallbackType::MspDeInit) + 1>
     callbackFunctions;
 
+// Statistics of the CAN, see Counters.hpp
+static System::Counter txFrames{"can.txFrames"};
+// Send() calls refused by HAL, e.g. all mailboxes full
+static System::Counter txRejected{"can.txRejected"};
+static System::Counter rxFrames{"can.rxFrames"};
+static System::Counter errors{"can.errors"};
+
 // Template from which HAL-compatible callback functions will be created, one
 // for each callback type.
 template <hCAN::CallbackType callbackType>
 void CANUniversalCallback([[maybe_unused]] CAN_HandleTypeDef* hcan)
 {
-    // Check if any entry with given key exists. Necessary to avoid allocating
-    // memory (which is not allowed in an ISR).
-    if(callbackFunctions.count(callbackType))
-        callbackFunctions.at(callbackType)();
+    if constexpr(callbackType == hCAN::CallbackType::Error)
+        errors.Increment();
+
+    callbackFunctions.Call<0, callbackType>();
 }
 
 hCAN::hCAN() noexcept
@@ -64,6 +91,8 @@ hCAN::hCAN() noexcept
     state = State::NOT_INITIALIZED;
     mode = Mode::NORMAL;
     baudRate = 250'000;
+    busOffCount = 0;
+    busOff = false;
 }
 
 void hCAN::Initialize()
@@ -192,6 +221,10 @@ void hCAN::Start()
 
     canHALErrorGuard(HAL_CAN_Start(&handle));
 
+    // Status change interrupt on entering bus-off, for GetErrorCounters()
+    canHALErrorGuard(
+        HAL_CAN_ActivateNotification(&handle, CAN_IT_BUSOFF | CAN_IT_ERROR));
+
     state = State::STARTED;
 }
 
@@ -260,6 +293,7 @@ void hCAN::GetRxMessage(uint32_t fifoId, uint32_t* extID, uint8_t* payload,
 {
     CAN_RxHeaderTypeDef header;
     canHALErrorGuard(HAL_CAN_GetRxMessage(&handle, fifoId, &header, payload));
+    rxFrames.Increment();
 
     (*extID) = header.IDE == CAN_ID_STD ? header.StdId : header.ExtId;
 
@@ -267,6 +301,22 @@ void hCAN::GetRxMessage(uint32_t fifoId, uint32_t* extID, uint8_t* payload,
     (*filterBankIdx) = header.FilterMatchIndex;
 }
 
+void hCAN::GetTxMailboxMessage(uint32_t mailbox, uint32_t* extID,
+                               uint8_t* payload) const
+{
+    const CAN_TxMailBox_TypeDef& txMailbox =
+        handle.Instance->sTxMailBox[mailbox];
+
+    (*extID) = (txMailbox.TIR & CAN_TI0R_EXID_Msk) >> CAN_TI0R_EXID_Pos;
+
+    const uint32_t low = txMailbox.TDLR;
+    const uint32_t high = txMailbox.TDHR;
+    for(size_t i = 0; i < 4; i++) {
+        payload[i] = static_cast<uint8_t>(low >> (8 * i));
+        payload[i + 4] = static_cast<uint8_t>(high >> (8 * i));
+    }
+}
+
 bool hCAN::IsAnyTxMailboxFree()
 {
     if(state != State::STARTED)
@@ -288,13 +338,20 @@ HAL_StatusTypeDef hCAN::Send(const uint32_t& id, uint8_t(data)[8])
     header.RTR = CAN_RTR_DATA;
     header.DLC = 8;
 
-    return HAL_CAN_AddTxMessage(&handle, &header, data, &usedMailbox);
+    const HAL_StatusTypeDef status =
+        HAL_CAN_AddTxMessage(&handle, &header, data, &usedMailbox);
+    if(status == HAL_OK)
+        txFrames.Increment();
+    else
+        txRejected.Increment();
+
+    return status;
 }
 
 void hCAN::RegisterCallback(CallbackType callbackType,
-                            std::function<void()> callbackFunction)
+                            Delegate callbackFunction)
 {
-    callbackFunctions[callbackType] = std::move(callbackFunction);
+    callbackFunctions.Set(0, callbackType, callbackFunction);
 }
 
 void hCAN::CalculateTQ()
@@ -386,16 +443,37 @@ void hCAN::CalculateTQ()
 
 void hCAN::SetBaudRate([[maybe_unused]] uint32_t _baudRate)
 {
+    // CAN bus speed must be below 1 MHz and at most 1/8 of the APB1 clock
     if(_baudRate > 1'000'000)
-        canError("CAN BUS speed must be below 1MHz!");
+        canError(ErrorCode::InvalidArgument, _baudRate);
     else if(_baudRate > Hardware::GetAPB1_Freq() / 8)
-        canError("Too high baud rate for this clock speed!");
+        canError(ErrorCode::InvalidArgument, _baudRate);
 
     baudRate = _baudRate;
 }
 
 void hCAN::SetMode(hCAN::Mode _mode) { mode = _mode; }
 
+hCAN::ErrorCounters hCAN::GetErrorCounters() const
+{
+    if(state == State::NOT_INITIALIZED)
+        return {0, 0, false, busOffCount};
+
+    const uint32_t esr = handle.Instance->ESR;
+    return {static_cast<uint8_t>((esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos),
+            static_cast<uint8_t>((esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos),
+            (esr & CAN_ESR_BOFF) != 0, busOffCount};
+}
+
+void hCAN::HandleStatusChange()
+{
+    // Interrupt fires on any enabled status change, count only entries
+    const bool nowBusOff = (handle.Instance->ESR & CAN_ESR_BOFF) != 0;
+    if(nowBusOff && !busOff)
+        busOffCount = busOffCount + 1;
+    busOff = nowBusOff;
+}
+
 hCAN can;
 } // namespace SBT::Hardware
 
@@ -406,4 +484,8 @@ using namespace SBT::Hardware;
 void CAN1_RX0_IRQHandler() { HAL_CAN_IRQHandler(&can.GetHandle()); }
 void CAN1_TX_IRQHandler() { HAL_CAN_IRQHandler(&can.GetHandle()); }
 void CAN1_RX1_IRQHandler() { HAL_CAN_IRQHandler(&can.GetHandle()); }
-void CAN1_SCE_IRQHandler() { HAL_CAN_IRQHandler(&can.GetHandle()); }
\ No newline at end of file
+void CAN1_SCE_IRQHandler()
+{
+    can.HandleStatusChange();
+    HAL_CAN_IRQHandler(&can.GetHandle());
+}
\ No newline at end of file
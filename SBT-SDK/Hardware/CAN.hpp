@@ -5,8 +5,8 @@
 #ifndef F1XX_PROJECT_TEMPLATE_CAN_HPP
 #define F1XX_PROJECT_TEMPLATE_CAN_HPP
 
+#include "Delegate.hpp"
 #include "stm32f1xx_hal.h"
-#include <functional>
 
 namespace SBT::Hardware {
 class hCAN {
@@ -90,6 +90,10 @@ private:
 
     CAN_HandleTypeDef handle;
 
+    // Written only by the status change interrupt
+    volatile uint32_t busOffCount;
+    volatile bool busOff;
+
     uint16_t prescaler; // 1-1024
     Mode mode;
     uint32_t baudRate;
@@ -101,6 +105,16 @@ private:
     void CalculateTQ();
 
 public:
+    // Fault confinement state of the node, see ST Reference manual at bxCAN
+    // chapter (CAN_ESR)
+    struct ErrorCounters {
+        uint8_t transmitErrors;
+        uint8_t receiveErrors;
+        bool busOff;
+        // Entries to bus-off state since reset
+        uint32_t busOffCount;
+    };
+
     hCAN() noexcept;
 
     /**
@@ -166,6 +180,18 @@ public:
      */
     void Stop();
 
+    /**
+     * @brief Read the error counters. Bus-off entries are counted by the
+     * status change interrupt, enabled by Start().
+     */
+    [[nodiscard]] ErrorCounters GetErrorCounters() const;
+
+    /**
+     * @brief Count bus-off entries, called by the status change interrupt
+     * handler
+     */
+    void HandleStatusChange();
+
     /**
      * @brief Checks if we can send message.
      * There are 3 TxMailboxes.
@@ -191,16 +217,27 @@ public:
     void GetRxMessage(uint32_t fifoId, uint32_t* extID, uint8_t* payload,
                       uint8_t* filterBankIdx);
 
+    /**
+     * @brief Read the message held by a TX mailbox. After transmission the
+     * mailbox keeps it until it is reused, so TX complete callbacks can tell
+     * which message was sent.
+     * @param mailbox mailbox number, 0-2
+     * @param extID pointer to CAN extended ID, which will be overwritten
+     * @param payload pointer to 8-byte payload, which will be overwritten
+     */
+    void GetTxMailboxMessage(uint32_t mailbox, uint32_t* extID,
+                             uint8_t* payload) const;
+
     /**
      * @brief Register a custom callback
      * @param callbackType Event which triggers the callback
-     * @param callbackFunction Void function taking no arguments. A regular
-     * function pointer will be casted to std::function implicitly. For a
-     * non-static class member function use the template version of
-     * RegisterCallback.
+     * @param callbackFunction Void function taking no arguments. A function
+     * pointer or a lambda capturing up to three pointers is converted to
+     * Delegate implicitly, without allocation. For a non-static class member
+     * function use the template version of RegisterCallback.
      */
     void RegisterCallback(CallbackType callbackType,
-                          std::function<void()> callbackFunction);
+                          Delegate callbackFunction);
 
     /**
      * @brief Register a non-static class member function as a custom callback
@@ -219,15 +256,14 @@ public:
      * @example RegisterCallback(CallbackType::RxFifo0MsgPending, this,
      * &myTask::myCallback);
      */
-    // This template envelopes the call of the member callback function in a
-    // lambda and passes it as an independent callback function.
+    // This template stores the object and the member callback function in a
+    // Delegate.
     template <class T>
     void RegisterCallback(CallbackType callbackType, T* callbackObject,
                           void (T::*callbackFunction)())
     {
-        RegisterCallback(callbackType, [callbackObject, callbackFunction]() {
-            (callbackObject->*callbackFunction)();
-        });
+        RegisterCallback(callbackType,
+                         Delegate(callbackObject, callbackFunction));
     }
 };
 
@@ -0,0 +1,57 @@
+#ifndef SBT_HARDWARE_CALLBACKREGISTRY_HPP
+#define SBT_HARDWARE_CALLBACKREGISTRY_HPP
+
+#include "Delegate.hpp"
+#include "Error.hpp"
+
+#include <cstddef>
+#include <stm32f1xx_hal.h>
+
+namespace SBT::Hardware {
+/**
+ * @brief User callbacks of a peripheral driver, in a fixed array indexed by
+ * instance number and HAL callback ID. HAL callbacks created from a template
+ * dispatch with Call<instance, type>() - a load and an indirect call, no
+ * lookup and no allocation.
+ * @tparam CallbackType driver's CallbackType enum, values are HAL callback IDs
+ * @tparam Instances number of peripheral instances
+ * @tparam Types highest callback ID + 1
+ */
+template <typename CallbackType, size_t Instances, size_t Types>
+class CallbackRegistry {
+public:
+    // Replace the callback, safe while interrupts are enabled
+    void Set(size_t instance, CallbackType callbackType, Delegate callback)
+    {
+        const auto type = static_cast<size_t>(callbackType);
+        if(instance >= Instances || type >= Types)
+            softfault({System::ErrorModule::CallbackRegistry,
+                       System::ErrorCode::InvalidInstance, __LINE__,
+                       static_cast<uint32_t>(instance)});
+
+        // Interrupt must not see a partially copied delegate
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        _callbacks[instance][type] = callback;
+        __set_PRIMASK(primask);
+    }
+
+    [[nodiscard]] bool IsSet(size_t instance, CallbackType callbackType) const
+    {
+        return !_callbacks[instance][static_cast<size_t>(callbackType)]
+                    .IsEmpty();
+    }
+
+    template <size_t instance, CallbackType callbackType> void Call() const
+    {
+        static_assert(instance < Instances);
+        static_assert(static_cast<size_t>(callbackType) < Types);
+        _callbacks[instance][static_cast<size_t>(callbackType)]();
+    }
+
+private:
+    Delegate _callbacks[Instances][Types];
+};
+} // namespace SBT::Hardware
+
+#endif // SBT_HARDWARE_CALLBACKREGISTRY_HPP
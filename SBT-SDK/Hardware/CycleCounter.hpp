@@ -0,0 +1,51 @@
+#ifndef SBT_HARDWARE_CYCLECOUNTER_HPP
+#define SBT_HARDWARE_CYCLECOUNTER_HPP
+
+#include <cstdint>
+#include <stm32f1xx_hal.h>
+
+namespace SBT::Hardware {
+/**
+ * @brief Cortex-M3 DWT cycle counter. Counts core clock cycles, wraps around
+ * after 2^32 cycles (~59 s at 72 MHz).
+ */
+class CycleCounter {
+public:
+    CycleCounter() = delete;
+
+    /**
+     * @brief Enable the counter, safe to call more than once
+     */
+    static void Enable()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    [[nodiscard]] static bool IsEnabled()
+    {
+        return (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0;
+    }
+
+    /**
+     * @brief Current value of the counter
+     */
+    [[nodiscard]] static uint32_t Get() { return DWT->CYCCNT; }
+
+    /**
+     * @brief Advance the counter by cycles it did not count, e.g. while the
+     * core slept. Cycles of the read-modify-write itself are lost.
+     */
+    static void Advance(uint32_t cycles) { DWT->CYCCNT += cycles; }
+
+    /**
+     * @brief Convert number of cycles to microseconds using current HCLK
+     */
+    [[nodiscard]] static uint32_t ToMicroseconds(uint32_t cycles)
+    {
+        return cycles / (HAL_RCC_GetHCLKFreq() / 1'000'000);
+    }
+};
+} // namespace SBT::Hardware
+
+#endif // SBT_HARDWARE_CYCLECOUNTER_HPP
@@ -3,19 +3,27 @@
 //
 
 #include "DMA.hpp"
+#include "Counters.hpp"
 #include "Error.hpp"
 
-static void dmaError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void dmaError(ErrorCode code, uint32_t argument = 0,
+                     uint16_t line = __builtin_LINE())
 {
-    softfault("DMA: " + comment);
+    softfault({SBT::System::ErrorModule::DMA, code, line, argument});
 }
 
-static void dmaErrorCtrlNotImpl() { dmaError("Controller is not implemented"); }
+static void dmaErrorCtrlNotImpl(uint16_t line = __builtin_LINE())
+{
+    dmaError(ErrorCode::NotImplemented, 0, line);
+}
 
-static void dmaHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void dmaHALErrorGuard(HAL_StatusTypeDef halStatus,
+                             uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        dmaError("HAL function failed with code " + std::to_string(halStatus));
+        dmaError(ErrorCode::HalFailure, halStatus, line);
 }
 
 namespace SBT::Hardware {
@@ -40,11 +48,10 @@ IRQn_Type DMA::GetChannelIRQ(const Channel channel)
 
 DMA_HandleTypeDef* DMA::GetChannelHandleNoError(const Channel channel)
 {
-    DMA_Channel_TypeDef* instance = GetChannelInstance(channel);
-    for(auto i : channels)
-        if(i->Instance == instance)
-            return i;
-    return nullptr;
+    DMA_HandleTypeDef& handle = channels[static_cast<size_t>(channel) - 1];
+    if(handle.Instance == nullptr)
+        return nullptr;
+    return &handle;
 }
 
 void DMA::InitController()
@@ -69,9 +76,10 @@ void DMA::CreateChannel(const Channel channel)
 {
     DMA_HandleTypeDef* handle = GetChannelHandleNoError(channel);
     if(handle != nullptr)
-        dmaError("Channel already exists");
+        dmaError(ErrorCode::AlreadyExists, static_cast<uint32_t>(channel));
 
-    handle = new DMA_HandleTypeDef;
+    handle = &channels[static_cast<size_t>(channel) - 1];
+    *handle = {};
     handle->Instance = GetChannelInstance(channel);
 
     // Set default values
@@ -84,8 +92,6 @@ void DMA::CreateChannel(const Channel channel)
         static_cast<uint32_t>(MemDataAlignment::Byte);
     handle->Init.Mode = static_cast<uint32_t>(Mode::Normal);
     handle->Init.Priority = static_cast<uint32_t>(Priority::Low);
-
-    channels.push_front(handle);
 }
 
 bool DMA::DoesChannelExist(Channel channel)
@@ -98,10 +104,7 @@ void DMA::DeleteChannel(const Channel channel)
     // A channel must be deinitialized before it can be deleted
     DeInitChannel(channel);
 
-    DMA_HandleTypeDef* handle = GetChannelHandle(channel);
-
-    channels.remove(handle);
-    delete handle;
+    GetChannelHandle(channel)->Instance = nullptr;
 }
 
 void DMA::SetChannelDirection(const Channel channel, const Direction direction)
@@ -167,7 +170,7 @@ DMA_HandleTypeDef* DMA::GetChannelHandle(const Channel channel)
 {
     DMA_HandleTypeDef* handle = GetChannelHandleNoError(channel);
     if(handle == nullptr)
-        dmaError("Channel does not exist");
+        dmaError(ErrorCode::DoesNotExist, static_cast<uint32_t>(channel));
     return handle;
 }
 
@@ -178,31 +181,28 @@ DMA dma1(DMA1);
 
 using namespace SBT::Hardware;
 
-void DMA1_Channel1_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel1));
-}
-void DMA1_Channel2_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel2));
-}
-void DMA1_Channel3_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel3));
-}
-void DMA1_Channel4_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel4));
-}
-void DMA1_Channel5_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel5));
-}
-void DMA1_Channel6_IRQHandler()
-{
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel6));
-}
-void DMA1_Channel7_IRQHandler()
+// Statistics of all DMA1 channels, see Counters.hpp
+static SBT::System::Counter dma1Transfers{"dma1.transfers"};
+static SBT::System::Counter dma1Errors{"dma1.errors"};
+
+static void dma1IRQHandler(DMA::Channel channel)
 {
-    HAL_DMA_IRQHandler(dma1.GetChannelHandle(DMA::Channel::Channel7));
+    DMA_HandleTypeDef* handle = dma1.GetChannelHandle(channel);
+
+    // Flags are cleared by the HAL handler
+    const uint32_t flags = handle->DmaBaseAddress->ISR >> handle->ChannelIndex;
+    if((flags & DMA_FLAG_TC1) != 0)
+        dma1Transfers.Increment();
+    if((flags & DMA_FLAG_TE1) != 0)
+        dma1Errors.Increment();
+
+    HAL_DMA_IRQHandler(handle);
 }
+
+void DMA1_Channel1_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel1); }
+void DMA1_Channel2_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel2); }
+void DMA1_Channel3_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel3); }
+void DMA1_Channel4_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel4); }
+void DMA1_Channel5_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel5); }
+void DMA1_Channel6_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel6); }
+void DMA1_Channel7_IRQHandler() { dma1IRQHandler(DMA::Channel::Channel7); }
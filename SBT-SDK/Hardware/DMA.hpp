@@ -5,7 +5,7 @@
 #ifndef F1XX_PROJECT_TEMPLATE_DMA_HPP
 #define F1XX_PROJECT_TEMPLATE_DMA_HPP
 
-#include <forward_list>
+#include <array>
 #include <stm32f1xx_hal.h>
 
 // How to use this driver:
@@ -70,8 +70,11 @@ public:
     };
 
 private:
-    // List of channel handles
-    std::forward_list<DMA_HandleTypeDef*> channels;
+    static constexpr size_t ChannelCount = 7;
+
+    // Channel handles indexed by channel number - 1. A handle with null
+    // Instance belongs to a channel which was not created.
+    std::array<DMA_HandleTypeDef, ChannelCount> channels{};
     DMA_TypeDef* const dma;
 
     DMA_Channel_TypeDef* GetChannelInstance(Channel);
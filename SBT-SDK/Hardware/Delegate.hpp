@@ -0,0 +1,70 @@
+#ifndef SBT_HARDWARE_DELEGATE_HPP
+#define SBT_HARDWARE_DELEGATE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace SBT::Hardware {
+template <typename Signature> class BasicDelegate;
+
+/**
+ * @brief Non-allocating replacement of std::function<void(Args...)> for
+ * callbacks. A copy of a small, trivially copyable callable - function
+ * pointer, lambda capturing up to three pointers, object with its member
+ * function - is kept in place. Calling costs one indirect call, an empty
+ * delegate calls a function which does nothing.
+ */
+template <typename... Args> class BasicDelegate<void(Args...)> {
+public:
+    static constexpr size_t StorageSize = 3 * sizeof(void*);
+
+    constexpr BasicDelegate() : _invoke(&Nothing), _storage{} {}
+
+    template <typename F, typename = std::enable_if_t<
+                              !std::is_same_v<std::decay_t<F>, BasicDelegate>>>
+    BasicDelegate(F callable) : _invoke(&Invoke<F>), _storage{}
+    {
+        static_assert(sizeof(F) <= StorageSize,
+                      "Delegate: callable is too big, capture less");
+        static_assert(alignof(F) <= alignof(void*),
+                      "Delegate: callable is over-aligned");
+        static_assert(std::is_trivially_copyable_v<F> &&
+                          std::is_trivially_destructible_v<F>,
+                      "Delegate: callable has to be trivially copyable, "
+                      "capture pointers instead of objects");
+        new(_storage) F(callable);
+    }
+
+    // Call a non-static member function on the object
+    template <class T>
+    BasicDelegate(T* object, void (T::*function)(Args...))
+        : BasicDelegate([object, function](Args... args) {
+              (object->*function)(args...);
+          })
+    {
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return _invoke == &Nothing; }
+
+    void operator()(Args... args) const { _invoke(_storage, args...); }
+
+private:
+    using InvokeFunction = void (*)(const void*, Args...);
+
+    static void Nothing(const void*, Args...) {}
+
+    template <typename F> static void Invoke(const void* storage, Args... args)
+    {
+        (*static_cast<const F*>(storage))(args...);
+    }
+
+    InvokeFunction _invoke;
+    alignas(void*) unsigned char _storage[StorageSize];
+};
+
+// Interrupt callbacks of the drivers
+using Delegate = BasicDelegate<void()>;
+} // namespace SBT::Hardware
+
+#endif // SBT_HARDWARE_DELEGATE_HPP
@@ -4,24 +4,49 @@
 
 #include "GPIO.hpp"
 #include "Error.hpp"
-#include <set>
+#include <array>
 
-static void gpioError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void gpioError(ErrorCode code, uint32_t argument = 0,
+                      uint16_t line = __builtin_LINE())
 {
-    softfault("GPIO: " + comment);
+    softfault({SBT::System::ErrorModule::GPIO, code, line, argument});
 }
 
-// Set of enabled pins
-static std::set<std::pair<GPIO_TypeDef*, uint32_t>> enabledPins;
+// Number of GPIO ports of the chip, ports are spaced 0x400 apart from GPIOA
+#if defined(GPIOG)
+static constexpr size_t gpioPortCount = 7;
+#elif defined(GPIOE)
+static constexpr size_t gpioPortCount = 5;
+#elif defined(GPIOD)
+static constexpr size_t gpioPortCount = 4;
+#else
+static constexpr size_t gpioPortCount = 3;
+#endif
+
+// Bitmap of enabled pins for every port, bit n is GPIO_PIN_n
+static std::array<uint16_t, gpioPortCount> enabledPins{};
+
+static uint16_t& getEnabledPins(GPIO_TypeDef* gpioPort)
+{
+    const size_t port = (reinterpret_cast<uintptr_t>(gpioPort) - GPIOA_BASE) /
+                        (GPIOB_BASE - GPIOA_BASE);
+    if(port >= enabledPins.size())
+        gpioError(ErrorCode::InvalidInstance,
+                  reinterpret_cast<uintptr_t>(gpioPort));
+    return enabledPins[port];
+}
 
 namespace SBT::Hardware {
 
 void GPIO::Enable(GPIO_TypeDef* gpioPort, uint32_t gpioPin, GPIO::Mode mode,
                   GPIO::Pull pull)
 {
-    // Check if the requested pin is already enabled
-    if(enabledPins.count({gpioPort, gpioPin}))
-        gpioError("Requested pin is already in use");
+    // Check if any of the requested pins is already enabled
+    uint16_t& portPins = getEnabledPins(gpioPort);
+    if(portPins & gpioPin)
+        gpioError(ErrorCode::AlreadyExists, gpioPin);
 
     GPIO_InitTypeDef initTypeDef;
     initTypeDef.Pin = gpioPin;
@@ -39,16 +64,17 @@ void GPIO::Enable(GPIO_TypeDef* gpioPort, uint32_t gpioPin, GPIO::Mode mode,
     HAL_GPIO_Init(gpioPort, &initTypeDef);
 
     // Register the requested pin as enabled
-    enabledPins.insert({gpioPort, gpioPin});
+    portPins |= gpioPin;
 }
 void GPIO::Disable(GPIO_TypeDef* gpioPort, uint32_t gpioPin)
 {
-    if(!enabledPins.count({gpioPort, gpioPin}))
-        gpioError("Requested pin is not in use");
+    uint16_t& portPins = getEnabledPins(gpioPort);
+    if((portPins & gpioPin) != gpioPin)
+        gpioError(ErrorCode::DoesNotExist, gpioPin);
 
     HAL_GPIO_DeInit(gpioPort, gpioPin);
 
-    enabledPins.erase({gpioPort, gpioPin});
+    portPins &= ~gpioPin;
 }
 void GPIO::Toggle(GPIO_TypeDef* gpioPort, uint32_t gpioPin)
 {
@@ -82,7 +108,8 @@ std::pair<ADC*, ADC::Channel> GPIO::GetAnalogChannel(GPIO_TypeDef* gpioPort,
     if(gpioPort == GPIOA)
         adc = &adc1;
     else
-        gpioError("No ADC for requested port");
+        gpioError(ErrorCode::NotImplemented,
+                  reinterpret_cast<uintptr_t>(gpioPort));
 
     // Compute ADC channel number from GPIO pin number
     uint32_t chn = 0;
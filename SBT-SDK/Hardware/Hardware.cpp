@@ -4,24 +4,28 @@
 #include <optional>
 #include <stm32f1xx_hal.h>
 
-static void hardwareError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void hardwareError(ErrorCode code, uint32_t argument = 0,
+                          uint16_t line = __builtin_LINE())
 {
-    softfault("Hardware: " + comment);
+    softfault({SBT::System::ErrorModule::Hardware, code, line, argument});
 }
 
-static void hardwareHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void hardwareHALErrorGuard(HAL_StatusTypeDef halStatus,
+                                  uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        hardwareError("HAL function failed with code " +
-                      std::to_string(halStatus));
+        hardwareError(ErrorCode::HalFailure, halStatus, line);
 }
 
 namespace SBT::Hardware {
 void configureClocks(uint32_t ahbFreq)
 {
     //-----------HERE----------------------
+    // Clock speed must be between 100'000 and 72'000'000
     if(ahbFreq < 100'000 || 72'000'000 < ahbFreq)
-        hardwareError("Clock speed must be between 100'000 and 72'000'000");
+        hardwareError(ErrorCode::InvalidArgument, ahbFreq);
 
     static const auto calculateBestAHBPrescalerAndPLLMUL =
         [ahbFreq]() -> std::pair<uint32_t, uint32_t> {
@@ -190,8 +194,9 @@ void StartWatchdog(IWDG_HandleTypeDef& hiwdg, unsigned watchdogTimeout_ms)
         }
     }
 
+    // Requested watchdog timeout value could not be achieved
     if(hiwdg.Init.Reload == 0)
-        hardwareError("Requested watchdog timeout value could not be achieved");
+        hardwareError(ErrorCode::InvalidArgument, watchdogTimeout_ms);
 
     // Prescaler and Reload values are directly written to the IWDG registers
     hiwdg.Init.Prescaler -= 2;
@@ -201,4 +206,18 @@ void StartWatchdog(IWDG_HandleTypeDef& hiwdg, unsigned watchdogTimeout_ms)
 }
 #endif
 
+uint8_t GetResetCause()
+{
+    static bool read = false;
+    static uint8_t cause = 0;
+
+    if(!read) {
+        // PINRSTF to LPWRRSTF are the top six bits, in the order of ResetCause
+        cause = static_cast<uint8_t>(RCC->CSR >> RCC_CSR_PINRSTF_Pos);
+        __HAL_RCC_CLEAR_RESET_FLAGS();
+        read = true;
+    }
+    return cause;
+}
+
 } // namespace SBT::Hardware
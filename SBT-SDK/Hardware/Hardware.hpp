@@ -14,6 +14,22 @@ uint32_t GetAPB1_Freq();
 uint32_t GetAPB2_Freq();
 
 void StartWatchdog(IWDG_HandleTypeDef&, unsigned);
+
+// Sources of the last reset, more than one may be set
+enum ResetCause : uint8_t {
+    ResetPin = 1 << 0,
+    ResetPowerOn = 1 << 1,
+    ResetSoftware = 1 << 2,
+    ResetIndependentWatchdog = 1 << 3,
+    ResetWindowWatchdog = 1 << 4,
+    ResetLowPower = 1 << 5
+};
+
+/**
+ * @brief Flags of ResetCause. The reset flags are read and cleared on the first
+ * call, done by System::Init(), so they describe only the last reset.
+ */
+uint8_t GetResetCause();
 } // namespace SBT::Hardware
 
 struct [[deprecated("Hardware components have been moved to the SBT::Hardware "
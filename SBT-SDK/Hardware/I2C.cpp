@@ -3,61 +3,115 @@
 //
 
 #include "I2C.hpp"
+#include "CallbackRegistry.hpp"
+#include "Counters.hpp"
 #include "Error.hpp"
 #include "GPIO.hpp"
 
-static void i2cError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void i2cError(ErrorCode code, uint32_t argument = 0,
+                     uint16_t line = __builtin_LINE())
 {
-    softfault("I2C: " + comment);
+    softfault({SBT::System::ErrorModule::I2C, code, line, argument});
 }
 
-static void i2cErrorNotInit() { i2cError("Not initialized"); }
+static void i2cErrorNotInit(uint16_t line = __builtin_LINE())
+{
+    i2cError(ErrorCode::NotInitialized, 0, line);
+}
 
-static void i2cErrorAlreadyInit() { i2cError("Already initialized"); }
+static void i2cErrorAlreadyInit(uint16_t line = __builtin_LINE())
+{
+    i2cError(ErrorCode::AlreadyInitialized, 0, line);
+}
 
-static void i2cErrorUnknownMode() { i2cError("How that even happen"); }
+static void i2cErrorUnknownMode(uint16_t line = __builtin_LINE())
+{
+    i2cError(ErrorCode::InvalidState, 0, line);
+}
 
-static void i2cErrorUnknownInstance()
+static void i2cErrorUnknownInstance(uint16_t line = __builtin_LINE())
 {
-    i2cError("Somehow instance not set to any I2C...");
+    i2cError(ErrorCode::InvalidInstance, 0, line);
 }
 
-static void i2cHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void i2cHALErrorGuard(HAL_StatusTypeDef halStatus,
+                             uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        i2cError("HAL function failed with code " + std::to_string(halStatus));
+        i2cError(ErrorCode::HalFailure, halStatus, line);
 }
 
 // Register a function created from the template as a callback. callbackType
 // must be a constant (literal) expression and not a variable as it is passed as
-// the template parameter and must be known at compile time.
-#define I2C_REGISTER_CALLBACK(hi2c, callbackType)                              \
+// the template parameter and must be known at compile time. index is the
+// number of the I2C instance.
+#define I2C_REGISTER_CALLBACK(hi2c, index, callbackType)                       \
     i2cHALErrorGuard(HAL_I2C_RegisterCallback(                                 \
         hi2c,                                                                  \
         static_cast<HAL_I2C_CallbackIDTypeDef>(CallbackType::callbackType),    \
-        I2CUniversalCallback<CallbackType::callbackType>));
+        i2cCallbacks<CallbackType::callbackType>[index]));
 
 namespace SBT::Hardware {
-// Nested unordered map containing callback functions for each callback type for
-// each I2C
-static std::unordered_map<
-    I2C_TypeDef*, std::unordered_map<I2C::CallbackType, std::function<void()>>>
+// Statistics of each I2C instance, see Counters.hpp
+struct I2CCounters {
+    // Bytes of started transfers
+    System::Counter txBytes;
+    System::Counter rxBytes;
+    // Transfers rejected because the previous one was in progress
+    System::Counter busy;
+    System::Counter errors;
+    // Transfers not acknowledged by the other side
+    System::Counter nacks;
+};
+
+#define I2C_COUNTERS(number)                                                   \
+    {                                                                          \
+        {"i2c" #number ".txBytes"}, {"i2c" #number ".rxBytes"},                \
+            {"i2c" #number ".busy"}, {"i2c" #number ".errors"},                \
+            {"i2c" #number ".nacks"},                                          \
+    }
+
+static I2CCounters counters[2] = {I2C_COUNTERS(1), I2C_COUNTERS(2)};
+
+// Count a transfer by its start status and pass the status on
+static HAL_StatusTypeDef countTransfer(HAL_StatusTypeDef status,
+                                       System::Counter& bytes,
+                                       System::Counter& busy, size_t numOfBytes)
+{
+    if(status == HAL_OK)
+        bytes.Add(numOfBytes);
+    else if(status == HAL_BUSY)
+        busy.Increment();
+    return status;
+}
+
+// Callback functions for each I2C and each callback type. MspDeInit has the
+// highest HAL callback ID.
+static CallbackRegistry<I2C::CallbackType, 2,
+                        static_cast<size_t>(I2C::CallbackType::MspDeInit) + 1>
     callbackFunctions;
 
 // Template from which HAL-compatible callback functions will be created, one
-// for each callback type.
-template <I2C::CallbackType callbackType>
-void I2CUniversalCallback(I2C_HandleTypeDef* hi2c)
-{
-    // Check if any entry with given key exists. Necessary to avoid allocating
-    // memory (which is not allowed in an ISR).
-    if(callbackFunctions.count(hi2c->Instance)) {
-        auto cfInstance = &callbackFunctions.at(hi2c->Instance);
-        if(cfInstance->count(callbackType))
-            cfInstance->at(callbackType)();
+// for each I2C and callback type.
+template <size_t index, I2C::CallbackType callbackType>
+void I2CUniversalCallback([[maybe_unused]] I2C_HandleTypeDef* hi2c)
+{
+    if constexpr(callbackType == I2C::CallbackType::Error) {
+        counters[index].errors.Increment();
+        if((hi2c->ErrorCode & HAL_I2C_ERROR_AF) != 0)
+            counters[index].nacks.Increment();
     }
+    callbackFunctions.Call<index, callbackType>();
 }
 
+// Callback functions of all I2C instances for one callback type
+template <I2C::CallbackType callbackType>
+constexpr void (*i2cCallbacks[])(I2C_HandleTypeDef*) = {
+    I2CUniversalCallback<0, callbackType>,
+    I2CUniversalCallback<1, callbackType>};
+
 void I2C::Initialize(uint32_t ownAddress)
 {
     if(initialized)
@@ -139,22 +193,23 @@ void I2C::Initialize(uint32_t ownAddress)
     }
 
     // Set up MspInit and MspDeInit callbacks
-    I2C_REGISTER_CALLBACK(&handle, MspInit)
-    I2C_REGISTER_CALLBACK(&handle, MspDeInit)
+    const size_t callbackIndex = static_cast<size_t>(instance) - 1;
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MspInit)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MspDeInit)
 
     // Set registers with prepared data
     i2cHALErrorGuard(HAL_I2C_Init(&handle));
 
     // Set up the remaining callbacks
-    I2C_REGISTER_CALLBACK(&handle, MasterTxComplete)
-    I2C_REGISTER_CALLBACK(&handle, MasterRxComplete)
-    I2C_REGISTER_CALLBACK(&handle, SlaveTxComplete)
-    I2C_REGISTER_CALLBACK(&handle, SlaveRxComplete)
-    I2C_REGISTER_CALLBACK(&handle, ListenComplete)
-    I2C_REGISTER_CALLBACK(&handle, MemTxComplete)
-    I2C_REGISTER_CALLBACK(&handle, MemRxComplete)
-    I2C_REGISTER_CALLBACK(&handle, Error)
-    I2C_REGISTER_CALLBACK(&handle, Abort)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MasterTxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MasterRxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, SlaveTxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, SlaveRxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, ListenComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MemTxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, MemRxComplete)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, Error)
+    I2C_REGISTER_CALLBACK(&handle, callbackIndex, Abort)
 
     initialized = true;
 }
@@ -222,11 +277,10 @@ void I2C::DeInitialize()
     }
 }
 
-void I2C::RegisterCallback(CallbackType callbackType,
-                           std::function<void()> callbackFunction)
+void I2C::RegisterCallback(CallbackType callbackType, Delegate callbackFunction)
 {
-    callbackFunctions[state.handle.Instance][callbackType] =
-        std::move(callbackFunction);
+    callbackFunctions.Set(static_cast<size_t>(instance) - 1, callbackType,
+                          callbackFunction);
 }
 
 HAL_StatusTypeDef I2C::SendMaster(uint16_t slaveAddress, uint8_t* data,
@@ -235,15 +289,20 @@ HAL_StatusTypeDef I2C::SendMaster(uint16_t slaveAddress, uint8_t* data,
     if(!initialized)
         i2cErrorNotInit();
 
+    I2CCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return SendMasterIT(slaveAddress, data, numOfBytes);
+        return countTransfer(SendMasterIT(slaveAddress, data, numOfBytes),
+                             counter.txBytes, counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return SendMasterRCC(slaveAddress, data, numOfBytes);
+        return countTransfer(SendMasterRCC(slaveAddress, data, numOfBytes),
+                             counter.txBytes, counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return SendMasterDMA(slaveAddress, data, numOfBytes);
+        return countTransfer(SendMasterDMA(slaveAddress, data, numOfBytes),
+                             counter.txBytes, counter.busy, numOfBytes);
         break;
     default:
         i2cErrorUnknownMode();
@@ -287,15 +346,20 @@ HAL_StatusTypeDef I2C::SendSlave(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         i2cErrorNotInit();
 
+    I2CCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return SendSlaveIT(data, numOfBytes);
+        return countTransfer(SendSlaveIT(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return SendSlaveRCC(data, numOfBytes);
+        return countTransfer(SendSlaveRCC(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return SendSlaveDMA(data, numOfBytes);
+        return countTransfer(SendSlaveDMA(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         i2cErrorUnknownMode();
@@ -334,15 +398,20 @@ HAL_StatusTypeDef I2C::ReceiveMaster(uint16_t slaveAddress, uint8_t* data,
     if(!initialized)
         i2cErrorNotInit();
 
+    I2CCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return ReceiveMasterIT(slaveAddress, data, numOfBytes);
+        return countTransfer(ReceiveMasterIT(slaveAddress, data, numOfBytes),
+                             counter.rxBytes, counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return ReceiveMasterRCC(slaveAddress, data, numOfBytes);
+        return countTransfer(ReceiveMasterRCC(slaveAddress, data, numOfBytes),
+                             counter.rxBytes, counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return ReceiveMasterDMA(slaveAddress, data, numOfBytes);
+        return countTransfer(ReceiveMasterDMA(slaveAddress, data, numOfBytes),
+                             counter.rxBytes, counter.busy, numOfBytes);
         break;
     default:
         i2cErrorUnknownMode();
@@ -386,15 +455,20 @@ HAL_StatusTypeDef I2C::ReceiveSlave(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         i2cErrorNotInit();
 
+    I2CCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return ReceiveSlaveIT(data, numOfBytes);
+        return countTransfer(ReceiveSlaveIT(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return ReceiveSlaveRCC(data, numOfBytes);
+        return countTransfer(ReceiveSlaveRCC(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return ReceiveSlaveDMA(data, numOfBytes);
+        return countTransfer(ReceiveSlaveDMA(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         i2cErrorUnknownMode();
@@ -608,7 +682,7 @@ I2C::I2C(I2C_TypeDef* i2cc)
         dmaChannelRx = DMA::Channel::Channel5;
     }
     else
-        i2cError("Please choose I2C_1 or I2C_2");
+        i2cError(ErrorCode::InvalidInstance);
 
     mode = OperatingMode::INTERRUPTS;
     addressingMode = AddressingMode::_7BIT;
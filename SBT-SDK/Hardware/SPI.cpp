@@ -3,63 +3,115 @@
 //
 
 #include "SPI.hpp"
+#include "CallbackRegistry.hpp"
+#include "Counters.hpp"
 #include "Error.hpp"
 #include "GPIO.hpp"
 #include "Hardware.hpp"
 
-static void spiError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void spiError(ErrorCode code, uint32_t argument = 0,
+                     uint16_t line = __builtin_LINE())
 {
-    softfault("SPI: " + comment);
+    softfault({SBT::System::ErrorModule::SPI, code, line, argument});
 }
 
-static void spiErrorNotInit() { spiError("Not initialized"); }
+static void spiErrorNotInit(uint16_t line = __builtin_LINE())
+{
+    spiError(ErrorCode::NotInitialized, 0, line);
+}
 
-static void spiErrorAlreadyInit() { spiError("Already initialized"); }
+static void spiErrorAlreadyInit(uint16_t line = __builtin_LINE())
+{
+    spiError(ErrorCode::AlreadyInitialized, 0, line);
+}
 
-static void spiErrorUnknownMode() { spiError("How that even happen"); }
+static void spiErrorUnknownMode(uint16_t line = __builtin_LINE())
+{
+    spiError(ErrorCode::InvalidState, 0, line);
+}
 
-static void spiErrorUnknownInstance()
+static void spiErrorUnknownInstance(uint16_t line = __builtin_LINE())
 {
-    spiError("Somehow instance not set to any SPI...");
+    spiError(ErrorCode::InvalidInstance, 0, line);
 }
 
-static void spiHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void spiHALErrorGuard(HAL_StatusTypeDef halStatus,
+                             uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        spiError("HAL function failed with code " + std::to_string(halStatus));
+        spiError(ErrorCode::HalFailure, halStatus, line);
 }
 
 // Register a function created from the template as a callback. callbackType
 // must be a constant (literal) expression and not a variable as it is passed as
-// the template parameter and must be known at compile time.
-#define SPI_REGISTER_CALLBACK(hspi, callbackType)                              \
+// the template parameter and must be known at compile time. index is the
+// number of the SPI instance.
+#define SPI_REGISTER_CALLBACK(hspi, index, callbackType)                       \
     spiHALErrorGuard(HAL_SPI_RegisterCallback(                                 \
         hspi,                                                                  \
         static_cast<HAL_SPI_CallbackIDTypeDef>(CallbackType::callbackType),    \
-        SPIUniversalCallback<CallbackType::callbackType>));
+        spiCallbacks<CallbackType::callbackType>[index]));
 
 namespace SBT::Hardware {
-// Nested unordered map containing callback functions for each callback type for
-// each SPI
-static std::unordered_map<
-    SPI_TypeDef*,
-    std::unordered_map<SPI_t::CallbackType, std::function<void()>>>
+// Statistics of each SPI instance, see Counters.hpp
+struct SPICounters {
+    // Bytes of started transfers
+    System::Counter txBytes;
+    System::Counter rxBytes;
+    // Transfers rejected because the previous one was in progress
+    System::Counter busy;
+    System::Counter errors;
+    System::Counter overruns;
+};
+
+#define SPI_COUNTERS(number)                                                   \
+    {                                                                          \
+        {"spi" #number ".txBytes"}, {"spi" #number ".rxBytes"},                \
+            {"spi" #number ".busy"}, {"spi" #number ".errors"},                \
+            {"spi" #number ".overruns"},                                       \
+    }
+
+static SPICounters counters[2] = {SPI_COUNTERS(1), SPI_COUNTERS(2)};
+
+// Count a transfer by its start status and pass the status on
+static HAL_StatusTypeDef countTransfer(HAL_StatusTypeDef status,
+                                       System::Counter& bytes,
+                                       System::Counter& busy, size_t numOfBytes)
+{
+    if(status == HAL_OK)
+        bytes.Add(numOfBytes);
+    else if(status == HAL_BUSY)
+        busy.Increment();
+    return status;
+}
+
+// Callback functions for each SPI and each callback type. MspDeInit has the
+// highest HAL callback ID.
+static CallbackRegistry<SPI_t::CallbackType, 2,
+                        static_cast<size_t>(SPI_t::CallbackType::MspDeInit) + 1>
     callbackFunctions;
 
 // Template from which HAL-compatible callback functions will be created, one
-// for each callback type.
-template <SPI_t::CallbackType callbackType>
-void SPIUniversalCallback(SPI_HandleTypeDef* hspi)
-{
-    // Check if any entry with given key exists. Necessary to avoid allocating
-    // memory (which is not allowed in an ISR).
-    if(callbackFunctions.count(hspi->Instance)) {
-        auto cfInstance = &callbackFunctions.at(hspi->Instance);
-        if(cfInstance->count(callbackType))
-            cfInstance->at(callbackType)();
+// for each SPI and callback type.
+template <size_t index, SPI_t::CallbackType callbackType>
+void SPIUniversalCallback([[maybe_unused]] SPI_HandleTypeDef* hspi)
+{
+    if constexpr(callbackType == SPI_t::CallbackType::Error) {
+        counters[index].errors.Increment();
+        if((hspi->ErrorCode & HAL_SPI_ERROR_OVR) != 0)
+            counters[index].overruns.Increment();
     }
+    callbackFunctions.Call<index, callbackType>();
 }
 
+// Callback functions of all SPI instances for one callback type
+template <SPI_t::CallbackType callbackType>
+constexpr void (*spiCallbacks[])(SPI_HandleTypeDef*) = {
+    SPIUniversalCallback<0, callbackType>,
+    SPIUniversalCallback<1, callbackType>};
+
 void SPI_t::Initialize()
 {
     if(initialized)
@@ -161,20 +213,21 @@ void SPI_t::Initialize()
     }
 
     // Set up MspInit and MspDeInit callbacks
-    SPI_REGISTER_CALLBACK(&handle, MspInit)
-    SPI_REGISTER_CALLBACK(&handle, MspDeInit)
+    const size_t callbackIndex = static_cast<size_t>(instance) - 1;
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, MspInit)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, MspDeInit)
 
     spiHALErrorGuard(HAL_SPI_Init(&handle));
 
     // Set up the remaining callbacks
-    SPI_REGISTER_CALLBACK(&handle, TxComplete)
-    SPI_REGISTER_CALLBACK(&handle, RxComplete)
-    SPI_REGISTER_CALLBACK(&handle, TxRxComplete)
-    SPI_REGISTER_CALLBACK(&handle, TxHalfComplete)
-    SPI_REGISTER_CALLBACK(&handle, RxHalfComplete)
-    SPI_REGISTER_CALLBACK(&handle, TxRxHalfComplete)
-    SPI_REGISTER_CALLBACK(&handle, Error)
-    SPI_REGISTER_CALLBACK(&handle, Abort)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, TxComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, RxComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, TxRxComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, TxHalfComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, RxHalfComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, TxRxHalfComplete)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, Error)
+    SPI_REGISTER_CALLBACK(&handle, callbackIndex, Abort)
 
     initialized = true;
 }
@@ -255,10 +308,10 @@ void SPI_t::DeInitialize()
 }
 
 void SPI_t::RegisterCallback(CallbackType callbackType,
-                             std::function<void()> callbackFunction)
+                             Delegate callbackFunction)
 {
-    callbackFunctions[state.handle.Instance][callbackType] =
-        std::move(callbackFunction);
+    callbackFunctions.Set(static_cast<size_t>(instance) - 1, callbackType,
+                          callbackFunction);
 }
 
 HAL_StatusTypeDef SPI_t::Send(uint8_t* data, size_t numOfBytes)
@@ -266,15 +319,20 @@ HAL_StatusTypeDef SPI_t::Send(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         spiErrorNotInit();
 
+    SPICounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return SendIT(data, numOfBytes);
+        return countTransfer(SendIT(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return SendRCC(data, numOfBytes);
+        return countTransfer(SendRCC(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return SendDMA(data, numOfBytes);
+        return countTransfer(SendDMA(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         spiErrorUnknownMode();
@@ -312,15 +370,20 @@ HAL_StatusTypeDef SPI_t::Receive(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         spiErrorNotInit();
 
+    SPICounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return ReceiveIT(data, numOfBytes);
+        return countTransfer(ReceiveIT(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return ReceiveRCC(data, numOfBytes);
+        return countTransfer(ReceiveRCC(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return ReceiveDMA(data, numOfBytes);
+        return countTransfer(ReceiveDMA(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         spiErrorUnknownMode();
@@ -385,7 +448,7 @@ SPI_t::SPI_t(SPI_TypeDef* spii)
         dmaChannelRx = DMA::Channel::Channel4;
     }
     else
-        spiError("Please choose SPI_1 or SPI_2");
+        spiError(ErrorCode::InvalidInstance);
 
     mode = OperatingMode::INTERRUPTS;
     dataSize = DataSize::_8BIT;
@@ -408,8 +471,9 @@ void SPI_t::SetPrescaler(SPI_t::Prescaler _prescaler)
 
 void SPI_t::SetBaudRate(int32_t _baudRate)
 {
+    // Baud rate for SPI must be between 1 and 18'000'000
     if(_baudRate < 1 || 18'000'000 < _baudRate)
-        spiError("Baud rate for SPI must be between 1 and 18'000'000");
+        spiError(ErrorCode::InvalidArgument, _baudRate);
 
     baudRate = _baudRate;
 }
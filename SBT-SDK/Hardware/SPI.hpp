@@ -6,7 +6,7 @@
 #define F1XX_PROJECT_TEMPLATE_SPI_HPP
 
 #include "DMA.hpp"
-#include <functional>
+#include "Delegate.hpp"
 #include <stm32f1xx_hal.h>
 
 namespace SBT::Hardware {
@@ -224,13 +224,13 @@ public:
     /**
      * @brief Register a custom callback
      * @param callbackType Event which triggers the callback
-     * @param callbackFunction Void function taking no arguments. A regular
-     * function pointer will be casted to std::function implicitly. For a
-     * non-static class member function use the template version of
-     * RegisterCallback.
+     * @param callbackFunction Void function taking no arguments. A function
+     * pointer or a lambda capturing up to three pointers is converted to
+     * Delegate implicitly, without allocation. For a non-static class member
+     * function use the template version of RegisterCallback.
      */
     void RegisterCallback(CallbackType callbackType,
-                          std::function<void()> callbackFunction);
+                          Delegate callbackFunction);
 
     /**
      * @brief Register a non-static class member function as a custom callback
@@ -249,15 +249,14 @@ public:
      * @example RegisterCallback(CallbackType::TxComplete, this,
      * &myTask::myCallback);
      */
-    // This template envelopes the call of the member callback function in a
-    // lambda and passes it as an independent callback function.
+    // This template stores the object and the member callback function in a
+    // Delegate.
     template <class T>
     void RegisterCallback(CallbackType callbackType, T* callbackObject,
                           void (T::*callbackFunction)())
     {
-        RegisterCallback(callbackType, [callbackObject, callbackFunction]() {
-            (callbackObject->*callbackFunction)();
-        });
+        RegisterCallback(callbackType,
+                         Delegate(callbackObject, callbackFunction));
     }
 
     /**
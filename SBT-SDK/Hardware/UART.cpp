@@ -3,64 +3,118 @@
 //
 
 #include "UART.hpp"
+#include "CallbackRegistry.hpp"
+#include "Counters.hpp"
 #include "Error.hpp"
 #include "GPIO.hpp"
 #include <cstdarg>
 #include <cstring>
 
-static void uartError(const std::string& comment)
+using SBT::System::ErrorCode;
+
+static void uartError(ErrorCode code, uint32_t argument = 0,
+                      uint16_t line = __builtin_LINE())
 {
-    softfault("UART: " + comment);
+    softfault({SBT::System::ErrorModule::UART, code, line, argument});
 }
 
-static void uartErrorNotInit() { uartError("Not initialized"); }
+static void uartErrorNotInit(uint16_t line = __builtin_LINE())
+{
+    uartError(ErrorCode::NotInitialized, 0, line);
+}
 
-static void uartErrorAlreadyInit() { uartError("Already initialized"); }
+static void uartErrorAlreadyInit(uint16_t line = __builtin_LINE())
+{
+    uartError(ErrorCode::AlreadyInitialized, 0, line);
+}
 
-static void uartErrorUnknownMode() { uartError("How that even happen"); }
+static void uartErrorUnknownMode(uint16_t line = __builtin_LINE())
+{
+    uartError(ErrorCode::InvalidState, 0, line);
+}
 
-static void uartErrorUnknownInstance()
+static void uartErrorUnknownInstance(uint16_t line = __builtin_LINE())
 {
-    uartError("Somehow instance not set to any UART...");
+    uartError(ErrorCode::InvalidInstance, 0, line);
 }
 
-static void uartHALErrorGuard(HAL_StatusTypeDef halStatus)
+static void uartHALErrorGuard(HAL_StatusTypeDef halStatus,
+                              uint16_t line = __builtin_LINE())
 {
     if(halStatus != HAL_OK)
-        uartError("HAL function failed with code " + std::to_string(halStatus));
+        uartError(ErrorCode::HalFailure, halStatus, line);
 }
 
 // Register a function created from the template as a callback. callbackType
 // must be a constant (literal) expression and not a variable as it is passed as
-// the template parameter and must be known at compile time.
-#define UART_REGISTER_CALLBACK(huart, callbackType)                            \
+// the template parameter and must be known at compile time. index is the
+// number of the UART instance.
+#define UART_REGISTER_CALLBACK(huart, index, callbackType)                     \
     uartHALErrorGuard(HAL_UART_RegisterCallback(                               \
         huart,                                                                 \
         static_cast<HAL_UART_CallbackIDTypeDef>(CallbackType::callbackType),   \
-        UARTUniversalCallback<CallbackType::callbackType>));
+        uartCallbacks<CallbackType::callbackType>[index]));
 
 namespace SBT::Hardware {
-// Nested unordered map containing callback functions for each callback type for
-// each UART
-static std::unordered_map<
-    USART_TypeDef*,
-    std::unordered_map<UART::CallbackType, std::function<void()>>>
+// Statistics of each UART instance, see Counters.hpp
+struct UARTCounters {
+    // Bytes of started transfers
+    System::Counter txBytes;
+    System::Counter rxBytes;
+    // Transfers rejected because the previous one was in progress
+    System::Counter busy;
+    System::Counter errors;
+    System::Counter overruns;
+};
+
+#define UART_COUNTERS(number)                                                  \
+    {                                                                          \
+        {"uart" #number ".txBytes"}, {"uart" #number ".rxBytes"},              \
+            {"uart" #number ".busy"}, {"uart" #number ".errors"},              \
+            {"uart" #number ".overruns"},                                      \
+    }
+
+static UARTCounters counters[3] = {UART_COUNTERS(1), UART_COUNTERS(2),
+                                   UART_COUNTERS(3)};
+
+// Count a transfer by its start status and pass the status on
+static HAL_StatusTypeDef countTransfer(HAL_StatusTypeDef status,
+                                       System::Counter& bytes,
+                                       System::Counter& busy, size_t numOfBytes)
+{
+    if(status == HAL_OK)
+        bytes.Add(numOfBytes);
+    else if(status == HAL_BUSY)
+        busy.Increment();
+    return status;
+}
+
+// Callback functions for each UART and each callback type. MspDeInit has the
+// highest HAL callback ID.
+static CallbackRegistry<UART::CallbackType, 3,
+                        static_cast<size_t>(UART::CallbackType::MspDeInit) + 1>
     callbackFunctions;
 
 // Template from which HAL-compatible callback functions will be created, one
-// for each callback type.
-template <UART::CallbackType callbackType>
-void UARTUniversalCallback(UART_HandleTypeDef* huart)
-{
-    // Check if any entry with given key exists. Necessary to avoid allocating
-    // memory (which is not allowed in an ISR).
-    if(callbackFunctions.count(huart->Instance)) {
-        auto cfInstance = &callbackFunctions.at(huart->Instance);
-        if(cfInstance->count(callbackType))
-            cfInstance->at(callbackType)();
+// for each UART and callback type.
+template <size_t index, UART::CallbackType callbackType>
+void UARTUniversalCallback([[maybe_unused]] UART_HandleTypeDef* huart)
+{
+    if constexpr(callbackType == UART::CallbackType::Error) {
+        counters[index].errors.Increment();
+        if((huart->ErrorCode & HAL_UART_ERROR_ORE) != 0)
+            counters[index].overruns.Increment();
     }
+    callbackFunctions.Call<index, callbackType>();
 }
 
+// Callback functions of all UART instances for one callback type
+template <UART::CallbackType callbackType>
+constexpr void (*uartCallbacks[])(UART_HandleTypeDef*) = {
+    UARTUniversalCallback<0, callbackType>,
+    UARTUniversalCallback<1, callbackType>,
+    UARTUniversalCallback<2, callbackType>};
+
 void UART::Initialize()
 {
 
@@ -149,21 +203,22 @@ void UART::Initialize()
     }
 
     // Set up MspInit and MspDeInit callbacks
-    UART_REGISTER_CALLBACK(&state.handle, MspInit)
-    UART_REGISTER_CALLBACK(&state.handle, MspDeInit)
+    const size_t callbackIndex = static_cast<size_t>(instance) - 1;
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, MspInit)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, MspDeInit)
 
     // Set registers with prepared data
     uartHALErrorGuard(HAL_UART_Init(&state.handle));
 
     // Set up the remaining callbacks
-    UART_REGISTER_CALLBACK(&state.handle, TxHalfComplete)
-    UART_REGISTER_CALLBACK(&state.handle, TxComplete)
-    UART_REGISTER_CALLBACK(&state.handle, RxHalfComplete)
-    UART_REGISTER_CALLBACK(&state.handle, RxComplete)
-    UART_REGISTER_CALLBACK(&state.handle, Error)
-    UART_REGISTER_CALLBACK(&state.handle, AbortComplete)
-    UART_REGISTER_CALLBACK(&state.handle, AbortTxComplete)
-    UART_REGISTER_CALLBACK(&state.handle, AbortRxComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, TxHalfComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, TxComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, RxHalfComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, RxComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, Error)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, AbortComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, AbortTxComplete)
+    UART_REGISTER_CALLBACK(&state.handle, callbackIndex, AbortRxComplete)
 
     initialized = true;
 }
@@ -248,10 +303,10 @@ void UART::DeInitialize()
 }
 
 void UART::RegisterCallback(CallbackType callbackType,
-                            std::function<void()> callbackFunction)
+                            Delegate callbackFunction)
 {
-    callbackFunctions[state.handle.Instance][callbackType] =
-        std::move(callbackFunction);
+    callbackFunctions.Set(static_cast<size_t>(instance) - 1, callbackType,
+                          callbackFunction);
 }
 
 HAL_StatusTypeDef UART::Send(uint8_t* data, size_t numOfBytes)
@@ -259,15 +314,20 @@ HAL_StatusTypeDef UART::Send(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         uartErrorNotInit();
 
+    UARTCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return SendIT(data, numOfBytes);
+        return countTransfer(SendIT(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return SendRCC(data, numOfBytes);
+        return countTransfer(SendRCC(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return SendDMA(data, numOfBytes);
+        return countTransfer(SendDMA(data, numOfBytes), counter.txBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         uartErrorUnknownMode();
@@ -306,15 +366,20 @@ HAL_StatusTypeDef UART::Receive(uint8_t* data, size_t numOfBytes)
     if(!initialized)
         uartErrorNotInit();
 
+    UARTCounters& counter = counters[static_cast<size_t>(instance) - 1];
+
     switch(mode) {
     case OperatingMode::INTERRUPTS:
-        return ReceiveIT(data, numOfBytes);
+        return countTransfer(ReceiveIT(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::BLOCKING:
-        return ReceiveRCC(data, numOfBytes);
+        return countTransfer(ReceiveRCC(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     case OperatingMode::DMA:
-        return ReceiveDMA(data, numOfBytes);
+        return countTransfer(ReceiveDMA(data, numOfBytes), counter.rxBytes,
+                             counter.busy, numOfBytes);
         break;
     default:
         uartErrorUnknownMode();
@@ -393,7 +458,7 @@ UART::UART(USART_TypeDef* usart)
         dmaChannelRx = DMA::Channel::Channel3;
     }
     else
-        uartError("Please choose UART_1, UART_2 or UART_3");
+        uartError(ErrorCode::InvalidInstance);
 
     mode = OperatingMode::INTERRUPTS;
     wordLength = WordLength::_8BITS;
@@ -17,6 +17,7 @@
 #endif
 
 #include "Hardware.hpp"
+#include "Time.hpp"
 
 #ifndef SBT_HEARTBEAT_DISABLE
 #include "Heartbeat.hpp"
@@ -27,6 +28,41 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if configSUPPORT_STATIC_ALLOCATION == 1
+#include "StaticTask.hpp"
+#endif
+
+#ifdef SBT_STACK_MONITOR
+#include "StackMonitor.hpp"
+#endif
+
+#ifdef SBT_JOB_SCHEDULER
+#include "JobScheduler.hpp"
+#endif
+
+#ifdef SBT_TICKLESS_IDLE
+#include "LowPower.hpp"
+#endif
+
+#ifdef SBT_TASK_SUPERVISOR
+#include "TaskSupervisor.hpp"
+#endif
+
+#ifdef SBT_CRASH_DUMP
+#include "CrashDump.hpp"
+#endif
+
+#ifdef SBT_TIME_SYNC
+#include "TimeSync.hpp"
+#endif
+
+#ifdef SBT_SCHEDULABILITY
+#include "Error.hpp"
+#include "Schedulability.hpp"
+
+#include <cstring>
+#endif
+
 #ifndef SBT_DEBUG
 static IWDG_HandleTypeDef hiwdg;
 #endif
@@ -35,17 +71,123 @@ extern "C" {
 void xPortSysTickHandler();
 void vApplicationIdleHook(void)
 {
-#ifndef SBT_DEBUG
+    // With SBT_TASK_SUPERVISOR the watchdog is refreshed from the tick hook
+#if !defined(SBT_DEBUG) && !defined(SBT_TASK_SUPERVISOR)
     HAL_IWDG_Refresh(&hiwdg);
 #endif
+#ifdef SBT_TASK_SUPERVISOR
+    SBT::System::TaskSupervisor::IdleCheckIn();
+#endif
+}
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+void vApplicationGetIdleTaskMemory(StaticTask_t** ppxIdleTaskTCBBuffer,
+                                   StackType_t** ppxIdleTaskStackBuffer,
+                                   uint32_t* pulIdleTaskStackSize)
+{
+    static StaticTask_t idleTaskTCB;
+    static StackType_t idleTaskStack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idleTaskTCB;
+    *ppxIdleTaskStackBuffer = idleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if configUSE_TIMERS == 1
+void vApplicationGetTimerTaskMemory(StaticTask_t** ppxTimerTaskTCBBuffer,
+                                    StackType_t** ppxTimerTaskStackBuffer,
+                                    uint32_t* pulTimerTaskStackSize)
+{
+    static StaticTask_t timerTaskTCB;
+    static StackType_t timerTaskStack[configTIMER_TASK_STACK_DEPTH];
+
+    *ppxTimerTaskTCBBuffer = &timerTaskTCB;
+    *ppxTimerTaskStackBuffer = timerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
 }
+#endif
+#endif
 }
 
+// System tasks. With SBT_STATIC_ALLOCATION their stacks and TCBs are reserved
+// at compile time, otherwise startTasks() takes them from the FreeRTOS heap.
+namespace {
+using namespace SBT::System;
+#if configSUPPORT_STATIC_ALLOCATION == 1
+template <typename T> using SystemTask = StaticTask<T>;
+#else
+template <typename T> using SystemTask = T;
+#endif
+#ifndef SBT_JOB_SCHEDULER
+#ifndef SBT_HEARTBEAT_DISABLE
+SystemTask<Tasks::Heartbeat> heartbeatTask;
+#endif
+#endif
+#ifndef SBT_CAN_DISABLE
+#ifndef SBT_CAN_SENDER_DISABLE
+SystemTask<Tasks::CanSender> canSenderTask;
+#endif
+#ifndef SBT_CAN_RECEIVER_DISABLE
+SystemTask<Tasks::CanReceiver> canReceiverTask;
+#endif
+#endif
+} // namespace
+
+#ifdef SBT_JOB_SCHEDULER
+#ifndef SBT_JOB_SCHEDULER_STACK_SIZE
+#define SBT_JOB_SCHEDULER_STACK_SIZE 128
+#endif
+
+// Shared task of system and user jobs
+namespace {
+using namespace SBT::System;
+#if configSUPPORT_STATIC_ALLOCATION == 1
+StaticTask<JobScheduler, SBT_JOB_SCHEDULER_STACK_SIZE>
+    jobScheduler("Jobs", 9, SBT_JOB_SCHEDULER_STACK_SIZE);
+#else
+JobScheduler jobScheduler("Jobs", 9, SBT_JOB_SCHEDULER_STACK_SIZE);
+#endif
+#ifndef SBT_HEARTBEAT_DISABLE
+Tasks::Heartbeat heartbeatJob;
+#endif
+} // namespace
+#endif
+
+#ifdef SBT_SCHEDULABILITY
+// Interrupts measured for the response-time analysis
+namespace {
+size_t sysTickInterrupt = 0;
+#ifndef SBT_CAN_DISABLE
+size_t canRxInterrupt = 0;
+size_t canTxInterrupt = 0;
+// Shortest time between two frames at SBT_CAN_BAUDRATE
+uint32_t canFramePeriodUs = 0;
+#endif
+} // namespace
+#endif
+
 namespace SBT::System {
+#ifdef SBT_JOB_SCHEDULER
+JobScheduler& GetJobScheduler() { return jobScheduler; }
+#endif
+
 void Init()
 {
+#ifdef SBT_CRASH_DUMP
+    CrashDump::Initialize();
+#endif
+
+#ifdef SBT_SCHEDULABILITY
+    // Before HAL_Init() starts SysTick
+    sysTickInterrupt = Schedulability::DeclareInterrupt(
+        "SysTick", 1'000'000 / configTICK_RATE_HZ, 0);
+#endif
+
     HAL_Init();
     Hardware::configureClocks();
+    // Keep the reset flags of this boot, they are cleared by the first read
+    Hardware::GetResetCause();
+    Time::Initialize();
 
 #ifndef SBT_CAN_DISABLE
 
@@ -64,8 +206,20 @@ void Init()
     using namespace Hardware;
     using namespace System::Comm;
 
+#ifdef SBT_SCHEDULABILITY
+    // Shortest extended frame with interframe space is 67 bits
+    canFramePeriodUs = 67 * 1'000'000 / SBT_CAN_BAUDRATE;
+    canRxInterrupt =
+        Schedulability::DeclareInterrupt("CAN RX", canFramePeriodUs, 0);
+    canTxInterrupt =
+        Schedulability::DeclareInterrupt("CAN TX", canFramePeriodUs, 0);
+#endif
+
 #ifndef SBT_CAN_RECEIVER_DISABLE
     Hardware::can.RegisterCallback(hCAN::CallbackType::RxFifo0MsgPending, []() {
+#ifdef SBT_SCHEDULABILITY
+        Schedulability::InterruptProbe probe(canRxInterrupt);
+#endif
         CAN::CopyRxMessToQueue(CAN_RX_FIFO0);
     });
     //    Hardware::can.RegisterCallback(hCAN::CallbackType::RxFifo1MsgPending,
@@ -75,12 +229,48 @@ void Init()
 #endif
 
 #ifndef SBT_CAN_SENDER_DISABLE
+#ifdef SBT_SCHEDULABILITY
+    const auto txComplete = []() {
+        Schedulability::InterruptProbe probe(canTxInterrupt);
+        Tasks::CanSender::CanTxCompleteCallback();
+    };
+#else
+    const auto txComplete = Tasks::CanSender::CanTxCompleteCallback;
+#endif
+#ifdef SBT_TIME_SYNC_MASTER
+    // Sync frames are timestamped when their mailbox completes
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox0Complete,
+                                   [txComplete]() {
+                                       TimeSync::TxComplete(0);
+                                       txComplete();
+                                   });
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox1Complete,
+                                   [txComplete]() {
+                                       TimeSync::TxComplete(1);
+                                       txComplete();
+                                   });
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox2Complete,
+                                   [txComplete]() {
+                                       TimeSync::TxComplete(2);
+                                       txComplete();
+                                   });
+#else
     Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox0Complete,
-                                   Tasks::CanSender::CanTxCompleteCallback);
+                                   txComplete);
     Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox1Complete,
-                                   Tasks::CanSender::CanTxCompleteCallback);
+                                   txComplete);
     Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox2Complete,
-                                   Tasks::CanSender::CanTxCompleteCallback);
+                                   txComplete);
+#endif
+    // Without automatic retransmission a mailbox is also freed by lost
+    // arbitration or a transmit error, reported only by the error callback
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox0Abort,
+                                   txComplete);
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox1Abort,
+                                   txComplete);
+    Hardware::can.RegisterCallback(hCAN::CallbackType::TxMailbox2Abort,
+                                   txComplete);
+    Hardware::can.RegisterCallback(hCAN::CallbackType::Error, txComplete);
 #endif
 
     Hardware::can.Initialize();
@@ -95,24 +285,72 @@ void Init()
     NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4);
 }
 
+#ifdef SBT_SCHEDULABILITY
+// Declare budgets of event driven system tasks and check declared budgets of
+// all tasks
+static void AnalyseSchedulability()
+{
+#ifndef SBT_CAN_DISABLE
+    // Budgets of the CAN tasks depend on user callbacks, so they are declared
+    // only if given, with one release per shortest frame
+    [[maybe_unused]] const auto declare = [](const char* name,
+                                             uint32_t budgetUs) {
+        for(size_t i = 0; i < TaskManager::getTaskCount(); i++) {
+            const Task& task = TaskManager::getTask(i);
+            if(strcmp(task.getName(), name) == 0)
+                Schedulability::DeclareTask(task, canFramePeriodUs, budgetUs);
+        }
+    };
+#if defined(SBT_CAN_RECEIVER_BUDGET_US) && !defined(SBT_CAN_RECEIVER_DISABLE)
+    declare("CanReceiver", SBT_CAN_RECEIVER_BUDGET_US);
+#endif
+#if defined(SBT_CAN_SENDER_BUDGET_US) && !defined(SBT_CAN_SENDER_DISABLE)
+    declare("CanSender", SBT_CAN_SENDER_BUDGET_US);
+#endif
+#endif
+
+    const bool schedulable = Schedulability::Analyse();
+#ifdef SBT_DEBUG
+    // See Schedulability::GetResults()
+    if(!schedulable)
+        softfault({ErrorModule::Schedulability, ErrorCode::Unschedulable,
+                   __LINE__, 0});
+#else
+    static_cast<void>(schedulable);
+#endif
+}
+#endif
+
 void Start([[maybe_unused]] unsigned watchdogTimeout_ms)
 {
     // Register system tasks
 
+#ifdef SBT_JOB_SCHEDULER
 #ifndef SBT_HEARTBEAT_DISABLE
-    TaskManager::registerSystemTask(
-        std::make_shared<System::Tasks::Heartbeat>());
+    jobScheduler.addJob(heartbeatJob);
+    // Released at least every Heartbeat period
+    jobScheduler.setCheckInDeadline(3 * heartbeatJob.getPeriod());
+#endif
+    TaskManager::registerSystemTask(jobScheduler);
+#endif
+
+#ifndef SBT_JOB_SCHEDULER
+#ifndef SBT_HEARTBEAT_DISABLE
+    TaskManager::registerSystemTask(heartbeatTask);
+#endif
 #endif
 
 #ifndef SBT_CAN_DISABLE
 #ifndef SBT_CAN_SENDER_DISABLE
-    TaskManager::registerSystemTask(
-        std::make_shared<System::Tasks::CanSender>());
+    TaskManager::registerSystemTask(canSenderTask);
 #endif
 #ifndef SBT_CAN_RECEIVER_DISABLE
-    TaskManager::registerSystemTask(
-        std::make_shared<System::Tasks::CanReceiver>());
+    TaskManager::registerSystemTask(canReceiverTask);
+#endif
 #endif
+
+#ifdef SBT_SCHEDULABILITY
+    AnalyseSchedulability();
 #endif
 
     // Register all tasks in FreeRTOS - allocate local stack etc.
@@ -125,9 +363,35 @@ void Start([[maybe_unused]] unsigned watchdogTimeout_ms)
     Hardware::StartWatchdog(hiwdg, watchdogTimeout_ms);
 #endif
 
+#ifdef SBT_TASK_SUPERVISOR
+#ifdef SBT_DEBUG
+    TaskSupervisor::Initialize(nullptr);
+#else
+    TaskSupervisor::Initialize(&hiwdg);
+#endif
+#endif
+
+#ifdef SBT_TICKLESS_IDLE
+#ifdef SBT_DEBUG
+    LowPower::Initialize(nullptr, watchdogTimeout_ms);
+#else
+    LowPower::Initialize(&hiwdg, watchdogTimeout_ms);
+#endif
+#endif
+
 #ifndef SBT_CAN_DISABLE
     // Start CAN
     Hardware::can.Start();
+
+#ifdef SBT_TIME_SYNC
+    // Filters can be added only to started CAN
+    Comm::TimeSync::Initialize();
+#endif
+#endif
+
+#ifdef SBT_STACK_MONITOR
+    // While only main() runs on the main stack
+    StackMonitor::PaintMainStack();
 #endif
 
     // Start FreeRTOS Kernel
@@ -137,7 +401,12 @@ void Start([[maybe_unused]] unsigned watchdogTimeout_ms)
 
 void SystickHandler()
 {
+#ifdef SBT_SCHEDULABILITY
+    Schedulability::InterruptProbe probe(sysTickInterrupt);
+#endif
     HAL_IncTick();
+    // Cycle counter has to be read at least once per its wrap
+    static_cast<void>(Time::GetCycles());
 #if(INCLUDE_xTaskGetSchedulerState == 1)
     if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
 #endif /* INCLUDE_xTaskGetSchedulerState */
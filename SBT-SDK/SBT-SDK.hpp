@@ -7,6 +7,10 @@
 
 #include "TaskManager.hpp"
 
+#ifdef SBT_JOB_SCHEDULER
+#include "JobScheduler.hpp"
+#endif
+
 #include <string>
 
 namespace SBT::System {
@@ -20,6 +24,12 @@ void Init();
 void Start(unsigned watchdogTimeout_ms = 1000);
 
 void SystickHandler();
+
+#ifdef SBT_JOB_SCHEDULER
+// System task shared by periodic jobs (Heartbeat and user jobs). Jobs have to
+// be added before Start().
+JobScheduler& GetJobScheduler();
+#endif
 } // namespace SBT::System
 
 #endif // F1XX_PROJECT_TEMPLATE_SBT_SDK_HPP
@@ -0,0 +1,168 @@
+#ifndef SBT_SYSTEM_BLOCKPOOL_HPP
+#define SBT_SYSTEM_BLOCKPOOL_HPP
+
+#include "Error.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace SBT::System {
+/**
+ * @brief Pool of fixed size blocks with O(1) Allocate() and Free(), safe in
+ * tasks and interrupts without a critical section. Unlike pvPortMalloc() it
+ * never suspends the scheduler and its timing does not depend on the state
+ * of the pool, so buffers of messages and drivers can be borrowed in hot
+ * paths.
+ *
+ * Free blocks form a singly linked list of indices. The head holds the index
+ * of the first free block and a tag incremented by every change, so a
+ * compare-and-swap fails if the head was taken and given back in between
+ * (ABA problem).
+ *
+ * @example
+ *   BlockPool<64, 8> pool;
+ *   auto* buffer = static_cast<uint8_t*>(pool.Allocate());
+ *   pool.Free(buffer);
+ *
+ * @tparam BlockSize size of a block in bytes, rounded up to the alignment
+ * @tparam BlockCount number of blocks
+ */
+template <size_t BlockSize, size_t BlockCount> class BlockPool {
+    static_assert(BlockSize > 0, "BlockPool block size has to be positive");
+    static_assert(BlockCount > 0 && BlockCount < 0xFFFF,
+                  "BlockPool block count has to be in 1..65534");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "BlockPool needs lock-free 32-bit atomics");
+
+    static constexpr size_t alignment = alignof(std::max_align_t);
+    static constexpr uint32_t noBlock = 0xFFFF;
+    static constexpr uint32_t indexMask = 0xFFFF;
+    static constexpr uint32_t tagIncrement = 0x10000;
+
+public:
+    static constexpr size_t Size = (BlockSize + alignment - 1) / alignment *
+                                   alignment;
+    static constexpr size_t Count = BlockCount;
+
+    struct Statistics {
+        uint32_t used;
+        // Highest number of blocks in use since construction
+        uint32_t peakUsed;
+        // Allocate() calls which found the pool empty
+        uint32_t failures;
+    };
+
+    BlockPool()
+    {
+        for(size_t i = 0; i < BlockCount; i++)
+            _next[i].store(i + 1 < BlockCount ? i + 1 : noBlock,
+                           std::memory_order_relaxed);
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    /**
+     * @brief Take a block of Size bytes, content is not initialised
+     * @return nullptr if all blocks are in use
+     */
+    void* Allocate()
+    {
+        uint32_t head = _head.load(std::memory_order_acquire);
+        uint32_t index;
+        do {
+            index = head & indexMask;
+            if(index == noBlock) {
+                _failures.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        } while(!_head.compare_exchange_weak(
+            head,
+            ((head + tagIncrement) & ~indexMask) |
+                _next[index].load(std::memory_order_relaxed),
+            std::memory_order_acquire, std::memory_order_acquire));
+
+        const uint32_t used = _used.fetch_add(1, std::memory_order_relaxed) + 1;
+        uint32_t peak = _peakUsed.load(std::memory_order_relaxed);
+        while(used > peak && !_peakUsed.compare_exchange_weak(
+                                 peak, used, std::memory_order_relaxed)) {
+        }
+
+        return _blocks[index];
+    }
+
+    /**
+     * @brief Give back a block taken by Allocate() of this pool. Softfaults
+     * on a pointer which does not point to a block. nullptr is ignored.
+     */
+    void Free(void* block)
+    {
+        if(block == nullptr)
+            return;
+
+        const auto offset = reinterpret_cast<uintptr_t>(block) -
+                            reinterpret_cast<uintptr_t>(_blocks);
+        // Not a block of this pool, address of the block
+        if(offset >= sizeof(_blocks) || offset % Size != 0)
+            softfault({ErrorModule::BlockPool, ErrorCode::InvalidArgument,
+                       __LINE__,
+                       static_cast<uint32_t>(
+                           reinterpret_cast<uintptr_t>(block))});
+
+        const auto index = static_cast<uint32_t>(offset / Size);
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        do {
+            _next[index].store(head & indexMask, std::memory_order_relaxed);
+        } while(!_head.compare_exchange_weak(
+            head, ((head + tagIncrement) & ~indexMask) | index,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        _used.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Allocate a block and construct an object in it
+     * @return nullptr if all blocks are in use
+     */
+    template <typename T, typename... Args> T* Create(Args&&... args)
+    {
+        static_assert(sizeof(T) <= Size, "Object does not fit in the block");
+        static_assert(alignof(T) <= alignment, "Object alignment too large");
+
+        void* block = Allocate();
+        return block != nullptr ? new(block) T(std::forward<Args>(args)...)
+                                : nullptr;
+    }
+
+    // Destroy an object made by Create() and free its block
+    template <typename T> void Destroy(T* object)
+    {
+        if(object == nullptr)
+            return;
+
+        object->~T();
+        Free(object);
+    }
+
+    [[nodiscard]] Statistics GetStatistics() const
+    {
+        return {_used.load(std::memory_order_relaxed),
+                _peakUsed.load(std::memory_order_relaxed),
+                _failures.load(std::memory_order_relaxed)};
+    }
+
+private:
+    alignas(alignment) uint8_t _blocks[BlockCount][Size];
+    std::atomic<uint32_t> _next[BlockCount];
+    // Tag in the upper half, index of the first free block in the lower
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _used{0};
+    std::atomic<uint32_t> _peakUsed{0};
+    std::atomic<uint32_t> _failures{0};
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_BLOCKPOOL_HPP
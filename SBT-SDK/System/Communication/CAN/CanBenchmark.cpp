@@ -0,0 +1,46 @@
+#include "CanBenchmark.hpp"
+#include "CycleCounter.hpp"
+#include "UART.hpp"
+
+namespace SBT::System::Comm {
+
+namespace {
+struct CycleTimer {
+    static uint32_t Now() { return Hardware::CycleCounter::Get(); }
+
+    static void Enter()
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+    }
+
+    static void Exit() { __set_PRIMASK(primask); }
+
+    static const char* Unit() { return "cycles"; }
+
+    static inline uint32_t primask;
+};
+} // namespace
+
+void RunCanBenchmark(Hardware::UART& uart, uint32_t iterations)
+{
+    // Buffer has to stay untouched until the previous transmission completes
+    static char line[128];
+
+    Hardware::CycleCounter::Enable();
+
+    Benchmark::Run<CycleTimer>(
+        iterations, [&uart](const Benchmark::Result& result) {
+            while(!uart.IsTxComplete()) {
+            }
+            const int length = Benchmark::Format(line, sizeof(line), result);
+            if(length > 0)
+                uart.Send(reinterpret_cast<uint8_t*>(line),
+                          static_cast<size_t>(length));
+        });
+
+    while(!uart.IsTxComplete()) {
+    }
+}
+
+} // namespace SBT::System::Comm
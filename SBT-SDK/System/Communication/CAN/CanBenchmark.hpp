@@ -0,0 +1,200 @@
+#ifndef SBT_SYSTEM_COMM_CAN_BENCHMARK_HPP
+#define SBT_SYSTEM_COMM_CAN_BENCHMARK_HPP
+
+#include "CanCatalog.hpp"
+#include "CanIDCodec.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Micro-benchmarks of the generated Pack_* / Unpack_* functions and of
+ * the ID codec used by GenericMessage::CalculateExtID and RxMessage getters.
+ * The same cases run on host (Tools/CanBenchmark) and on target
+ * (RunCanBenchmark() in CanBenchmark.cpp), only the Timer differs.
+ *
+ * Timer has to provide:
+ * - static uint32_t Now() - current tick count (wrap-around is fine)
+ * - static void Enter(), static void Exit() - called around every measured
+ *   loop, e.g. to disable interrupts
+ * - static const char* Unit() - name of a tick, e.g. "cycles" or "ns"
+ *
+ * Every case is reported as one JSON line:
+ * {"case":"HEARTBEAT","op":"unpack","iterations":1000,"ticks":12000,
+ *  "baseline":2000,"unit":"cycles"}
+ * ticks is the total time of all iterations, baseline the time of the same
+ * loop with an empty body, so the cost of one call is
+ * (ticks - baseline) / iterations.
+ */
+
+namespace SBT::System::Comm::Benchmark {
+
+struct Result {
+    const char* name;
+    const char* operation;
+    uint32_t iterations;
+    uint32_t ticks;
+    uint32_t baseline;
+    const char* unit;
+};
+
+/**
+ * @brief Format result as a JSON line (with trailing newline)
+ * @return number of characters written, as returned by snprintf
+ */
+inline int Format(char* buffer, size_t size, const Result& result)
+{
+    return snprintf(buffer, size,
+                    "{\"case\":\"%s\",\"op\":\"%s\",\"iterations\":%lu,"
+                    "\"ticks\":%lu,\"baseline\":%lu,\"unit\":\"%s\"}\n",
+                    result.name, result.operation,
+                    static_cast<unsigned long>(result.iterations),
+                    static_cast<unsigned long>(result.ticks),
+                    static_cast<unsigned long>(result.baseline), result.unit);
+}
+
+// Keep the compiler from removing or hoisting the benchmarked call
+template <typename T> inline void DoNotOptimize(T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+template <typename Timer, typename Body>
+uint32_t Measure(uint32_t iterations, Body&& body)
+{
+    Timer::Enter();
+    const uint32_t start = Timer::Now();
+    for(uint32_t i = 0; i < iterations; i++)
+        body(i);
+    const uint32_t ticks = Timer::Now() - start;
+    Timer::Exit();
+    return ticks;
+}
+
+// Deterministic payloads, so runs are comparable between builds
+inline void FillPayload(uint8_t (&payload)[8], uint32_t seed)
+{
+    uint32_t state = seed * 2654435761U + 1;
+    for(auto& byte : payload) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        byte = static_cast<uint8_t>(state);
+    }
+}
+
+/**
+ * @brief Run all cases and pass every Result to report
+ * @param iterations number of calls measured in every case
+ * @param report callable taking const Result&, called outside of measurement
+ */
+template <typename Timer, typename Report>
+void Run(uint32_t iterations, Report&& report)
+{
+    using namespace CAN_ID;
+
+    uint8_t payload[8];
+    const uint32_t baseline = Measure<Timer>(
+        iterations, [&payload](uint32_t) { DoNotOptimize(payload); });
+
+    const auto emit = [&](const char* name, const char* operation,
+                          uint32_t ticks) {
+        report(Result{name, operation, iterations, ticks, baseline,
+                      Timer::Unit()});
+    };
+
+#define SBT_BENCHMARK_MESSAGE(NAME)                                            \
+    {                                                                          \
+        FillPayload(payload, static_cast<uint32_t>(Param::NAME));              \
+        NAME##_t message = Unpack_##NAME(payload);                             \
+        emit(#NAME, "unpack",                                                  \
+             Measure<Timer>(iterations, [&](uint32_t) {                        \
+                 message = Unpack_##NAME(payload);                             \
+                 DoNotOptimize(message);                                       \
+             }));                                                              \
+        emit(#NAME, "pack", Measure<Timer>(iterations, [&](uint32_t) {         \
+                 Pack_##NAME(&message, payload);                               \
+                 DoNotOptimize(payload);                                       \
+             }));                                                              \
+        uint32_t extID = 0;                                                    \
+        emit(#NAME, "encode_id", Measure<Timer>(iterations, [&](uint32_t i) {  \
+                 extID = EncodeExtID(static_cast<Source>(i & 0x0F),            \
+                                     Message::NAME);                           \
+                 DoNotOptimize(extID);                                         \
+             }));                                                              \
+        emit(#NAME, "decode_id", Measure<Timer>(iterations, [&](uint32_t) {    \
+                 DoNotOptimize(extID);                                         \
+                 auto source = DecodeSource(extID);                            \
+                 auto decoded = DecodeMessage(extID);                          \
+                 DoNotOptimize(source);                                        \
+                 DoNotOptimize(decoded);                                       \
+             }));                                                              \
+    }
+
+    SBT_CAN_CATALOG(SBT_BENCHMARK_MESSAGE)
+#undef SBT_BENCHMARK_MESSAGE
+
+    // Receive path at saturated bus load: a stream of frames with different
+    // IDs, each passed to a callback which only uses the payload. "eager"
+    // decodes SubIDs of every frame before dispatch, "lazy" leaves decoding
+    // to callbacks which need it (RxMessage getters).
+    struct RxFrame {
+        uint32_t extID;
+        uint8_t payload[8];
+    };
+#define SBT_BENCHMARK_MESSAGE_ID(NAME) Message::NAME,
+    constexpr Message_t rxMessages[] = {
+        SBT_CAN_CATALOG(SBT_BENCHMARK_MESSAGE_ID)};
+#undef SBT_BENCHMARK_MESSAGE_ID
+    constexpr uint32_t rxFrameCount = 16;
+    RxFrame rxFrames[rxFrameCount];
+    for(uint32_t i = 0; i < rxFrameCount; i++) {
+        rxFrames[i].extID = EncodeExtID(static_cast<Source>(i),
+                                        rxMessages[i % catalogSize]);
+        FillPayload(rxFrames[i].payload, i);
+    }
+
+    uint32_t forwarded = 0;
+    const auto callback = [&forwarded](const RxFrame& frame) {
+        uint32_t word;
+        memcpy(&word, frame.payload, sizeof(word));
+        forwarded += word;
+        DoNotOptimize(forwarded);
+    };
+
+    emit("RX_DISPATCH", "eager", Measure<Timer>(iterations, [&](uint32_t i) {
+             const RxFrame& frame = rxFrames[i % rxFrameCount];
+             DoNotOptimize(frame);
+             auto source = DecodeSource(frame.extID);
+             auto decoded = DecodeMessage(frame.extID);
+             DoNotOptimize(source);
+             DoNotOptimize(decoded);
+             callback(frame);
+         }));
+    emit("RX_DISPATCH", "lazy", Measure<Timer>(iterations, [&](uint32_t i) {
+             const RxFrame& frame = rxFrames[i % rxFrameCount];
+             DoNotOptimize(frame);
+             callback(frame);
+         }));
+}
+
+} // namespace SBT::System::Comm::Benchmark
+
+namespace SBT::Hardware {
+class UART;
+}
+
+namespace SBT::System::Comm {
+/**
+ * @brief Run the benchmark on target, timed with the DWT cycle counter, and
+ * send results over initialized uart. Every case runs with interrupts
+ * disabled. Available when the SDK is built with SBT_CAN_BENCHMARK
+ * environment variable set.
+ * @param uart initialized UART used for output
+ * @param iterations number of calls measured in every case
+ */
+void RunCanBenchmark(Hardware::UART& uart, uint32_t iterations = 1000);
+} // namespace SBT::System::Comm
+
+#endif // SBT_SYSTEM_COMM_CAN_BENCHMARK_HPP
@@ -0,0 +1,140 @@
+#ifndef SBT_SYSTEM_COMM_CAN_CATALOG_HPP
+#define SBT_SYSTEM_COMM_CAN_CATALOG_HPP
+
+#include "CanID_autogenerated.hpp"
+#include "CanParser_autogenerated.hpp"
+
+/**
+ * @brief X-macro lists of all messages and their signals, as defined in
+ * CanID_autogenerated.hpp and CanParser_autogenerated.hpp. They let tools and
+ * benchmarks iterate over the whole catalog without repeating it.
+ * Keep them in sync with the generator output after every DBC change - the
+ * static_assert below catches a message missing from the list.
+ *
+ * Messages sent by the SDK itself (CPU_LOAD and later) are defined in
+ * SBT-SDK.dbc, to be merged into the project DBC before regenerating.
+ *
+ * SBT_CAN_CATALOG(X) calls X(NAME) for every message. For a message NAME there
+ * is CAN_ID::Message::NAME, NAME_t, Unpack_NAME() and Pack_NAME().
+ * SBT_CAN_SIGNALS_NAME(S) calls S(signal) for every signal of NAME_t.
+ */
+
+#define SBT_CAN_CATALOG(X)                                                     \
+    X(HEARTBEAT)                                                               \
+    X(LIFEPO4_GENERAL)                                                         \
+    X(LIFEPO4_CELLS_1)                                                         \
+    X(LIFEPO4_CELLS_2)                                                         \
+    X(LIFEPO4_CELLS_3)                                                         \
+    X(PUMPS_GENERAL)                                                           \
+    X(EMBEDDED_BUS_DATA)                                                       \
+    X(POWER_BUS_DATA)                                                          \
+    X(PV_DATA)                                                                 \
+    X(MPPT_CHARGER_DATA)                                                       \
+    X(YIELD_DATA)                                                              \
+    X(GEODETIC_POSITION_1)                                                     \
+    X(GEODETIC_POSITION_2)                                                     \
+    X(NED_VELOCITY)                                                            \
+    X(NED_HEADING)                                                             \
+    X(YOKE_GENERAL)                                                            \
+    X(PUMPS_THRESHOLD)                                                         \
+    X(TEMPERATURE_POWERBOX)                                                    \
+    X(CPU_LOAD)                                                                \
+    X(ERROR_LOG)                                                               \
+    X(CRASH_DUMP)                                                              \
+    X(HEARTBEAT_EXT)                                                           \
+    X(COUNTER)                                                                 \
+    X(TIME_SYNC)                                                               \
+    X(TIME_SYNC_FOLLOW_UP)                                                     \
+    X(TIME_SYNC_STATUS)
+
+#define SBT_CAN_SIGNALS_HEARTBEAT(S)                                           \
+    S(upTime) S(canTxMessFailCount) S(canRxMessFailCount)
+
+#define SBT_CAN_SIGNALS_LIFEPO4_GENERAL(S)                                     \
+    S(chargeCurrent) S(dischargingCurrent) S(voltage) S(percentage) S(state)
+
+#define SBT_CAN_SIGNALS_LIFEPO4_CELLS_1(S)                                     \
+    S(cellVoltage1) S(cellVoltage2) S(cellVoltage3) S(cellVoltage4)            \
+        S(cellVoltage5)
+
+#define SBT_CAN_SIGNALS_LIFEPO4_CELLS_2(S)                                     \
+    S(cellVoltage6) S(cellVoltage7) S(cellVoltage8) S(cellVoltage9)            \
+        S(cellVoltageA)
+
+#define SBT_CAN_SIGNALS_LIFEPO4_CELLS_3(S)                                     \
+    S(cellVoltageB) S(cellVoltageC) S(cellVoltageD) S(cellVoltageE) S(power)
+
+#define SBT_CAN_SIGNALS_PUMPS_GENERAL(S)                                       \
+    S(waterLevel1) S(waterLevel2) S(waterLevel3) S(waterLevel4)                \
+        S(statusPump1) S(statusPump2) S(statusPump3) S(statusPump4)            \
+            S(operatingModePump1) S(operatingModePump2)                        \
+                S(operatingModePump3) S(operatingModePump4) S(statusSiren)
+
+#define SBT_CAN_SIGNALS_EMBEDDED_BUS_DATA(S) S(voltage) S(current) S(power)
+
+#define SBT_CAN_SIGNALS_POWER_BUS_DATA(S) S(voltage) S(current) S(power)
+
+#define SBT_CAN_SIGNALS_PV_DATA(S)                                             \
+    S(panelPower) S(panelCurrent) S(panelVoltage)
+
+#define SBT_CAN_SIGNALS_MPPT_CHARGER_DATA(S)                                   \
+    S(internalTemperature) S(batteryCurrent) S(batteryVoltage)
+
+#define SBT_CAN_SIGNALS_YIELD_DATA(S) S(yieldToday) S(maximumPowerToday)
+
+#define SBT_CAN_SIGNALS_GEODETIC_POSITION_1(S) S(latitude) S(longitude)
+
+#define SBT_CAN_SIGNALS_GEODETIC_POSITION_2(S)                                 \
+    S(horizontalAccEst) S(verticalAccEst) S(hamsl) S(gpsFixType) S(gpsFixOK)
+
+#define SBT_CAN_SIGNALS_NED_VELOCITY(S)                                        \
+    S(speed) S(groundSpeed) S(speedAccEst)
+
+#define SBT_CAN_SIGNALS_NED_HEADING(S)                                         \
+    S(headingOfMotion) S(headingOfMotionAccEst)
+
+#define SBT_CAN_SIGNALS_YOKE_GENERAL(S)                                        \
+    S(enablePump1) S(enablePump2) S(enablePump3) S(enablePump4)                \
+        S(enableSiren) S(operatingModePump1) S(operatingModePump2)             \
+            S(operatingModePump3) S(operatingModePump4) S(resetEmbeddedBus)    \
+                S(resetPowerBus)
+
+#define SBT_CAN_SIGNALS_PUMPS_THRESHOLD(S)                                     \
+    S(thresholdWaterSensor1) S(thresholdWaterSensor2)                          \
+        S(thresholdWaterSensor3) S(thresholdWaterSensor4)
+
+#define SBT_CAN_SIGNALS_TEMPERATURE_POWERBOX(S) S(temperature1) S(temperature2)
+
+#define SBT_CAN_SIGNALS_CPU_LOAD(S)                                            \
+    S(idleLoad) S(taskCount) S(task1Number) S(task1Load) S(task2Number)        \
+        S(task2Load) S(task3Number) S(task3Load)
+
+#define SBT_CAN_SIGNALS_ERROR_LOG(S) S(module) S(code) S(line) S(argument)
+
+#define SBT_CAN_SIGNALS_CRASH_DUMP(S) S(index) S(count) S(value)
+
+#define SBT_CAN_SIGNALS_HEARTBEAT_EXT(S) S(page) S(value8) S(value16) S(value32)
+
+#define SBT_CAN_SIGNALS_COUNTER(S) S(index) S(count) S(id) S(value)
+
+#define SBT_CAN_SIGNALS_TIME_SYNC(S) S(sequence)
+
+#define SBT_CAN_SIGNALS_TIME_SYNC_FOLLOW_UP(S)                                 \
+    S(sequence) S(microseconds) S(seconds)
+
+#define SBT_CAN_SIGNALS_TIME_SYNC_STATUS(S) S(state) S(master) S(drift) S(error)
+
+namespace SBT::System::Comm::CAN_ID {
+
+#define SBT_CAN_CATALOG_COUNT(NAME) +1
+// Number of messages in the catalog
+constexpr unsigned catalogSize = 0 SBT_CAN_CATALOG(SBT_CAN_CATALOG_COUNT);
+#undef SBT_CAN_CATALOG_COUNT
+
+// Every Param apart from DEFAULT and UNKNOWN has to be listed in the catalog
+static_assert(catalogSize == static_cast<unsigned>(Param::UNKNOWN) - 1,
+              "SBT_CAN_CATALOG is out of sync with CanID_autogenerated.hpp");
+
+} // namespace SBT::System::Comm::CAN_ID
+
+#endif // SBT_SYSTEM_COMM_CAN_CATALOG_HPP
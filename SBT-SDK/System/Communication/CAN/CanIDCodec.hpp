@@ -0,0 +1,87 @@
+#ifndef SBT_SYSTEM_COMM_CAN_IDCODEC_HPP
+#define SBT_SYSTEM_COMM_CAN_IDCODEC_HPP
+
+#include <cstdint>
+
+#include "CanID_autogenerated.hpp"
+
+/**
+ * @brief Conversion between our SubIDs and the raw 29-bit extended CAN ID.
+ *
+ * Layout of the extended ID:
+ * | 28..26   | 25..18 | 17..14   | 13..6   | 5..0  |
+ * | priority | source | snapshot | paramID | group |
+ *
+ * snapshot is a counter shared by frames of one multi-frame snapshot (see
+ * CanSnapshot.hpp), 0 for ordinary messages. It uses the upper, previously
+ * always zero, bits of the old 12-bit paramID field.
+ *
+ * Compatibility: ordinary messages keep their IDs, so old and new nodes
+ * understand each other. Frames of a snapshot are not - decoders with the
+ * 12-bit paramID see an unknown param and filters with the 12-bit mask drop
+ * them. Nodes receiving snapshots and host tools (Tools/CanLogDecoder) have
+ * to be rebuilt with this header before any node is built with
+ * SBT_CAN_SNAPSHOT. ParamIDs above 0xFF can no longer be assigned.
+ *
+ * This header depends only on the generated ID definitions, so it can be used
+ * both on target and in host-side tools.
+ */
+namespace SBT::System::Comm::CAN_ID {
+
+static_assert(static_cast<uint16_t>(Param::UNKNOWN) <= 0xFF,
+              "paramID has to fit in 8 bits of the extended ID");
+
+// Number of distinct snapshot counter values
+constexpr uint8_t snapshotCount = 16;
+
+constexpr uint32_t EncodeExtID(Source sID, Message_t mID, uint8_t snapshot = 0)
+{
+    return (static_cast<uint32_t>(mID.priority & 0x07) << 26) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(sID)) << 18) |
+           (static_cast<uint32_t>(snapshot & 0x0F) << 14) |
+           ((static_cast<uint32_t>(static_cast<uint16_t>(mID.paramID)) & 0xFF)
+            << 6) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(mID.group)) & 0x3F);
+}
+
+constexpr uint8_t DecodePriority(uint32_t extID) { return (extID >> 26) & 0x07; }
+
+// To check if received ID is in range we keep our enums without gaps, and then
+// only check limit values
+constexpr Source DecodeSource(uint32_t extID)
+{
+    const uint16_t temp = (extID >> 18) & 0xFF;
+    return temp <= static_cast<uint16_t>(Source::UNKNOWN)
+               ? static_cast<Source>(temp)
+               : Source::UNKNOWN;
+}
+
+constexpr Param DecodeParam(uint32_t extID)
+{
+    const uint16_t temp = (extID >> 6) & 0xFF;
+    return temp <= static_cast<uint16_t>(Param::UNKNOWN)
+               ? static_cast<Param>(temp)
+               : Param::UNKNOWN;
+}
+
+constexpr uint8_t DecodeSnapshot(uint32_t extID)
+{
+    return (extID >> 14) & 0x0F;
+}
+
+constexpr Group DecodeGroup(uint32_t extID)
+{
+    const uint16_t temp = extID & 0x3F;
+    return temp <= static_cast<uint16_t>(Group::UNKNOWN)
+               ? static_cast<Group>(temp)
+               : Group::UNKNOWN;
+}
+
+constexpr Message_t DecodeMessage(uint32_t extID)
+{
+    return {DecodePriority(extID), DecodeParam(extID), DecodeGroup(extID)};
+}
+
+} // namespace SBT::System::Comm::CAN_ID
+
+#endif // SBT_SYSTEM_COMM_CAN_IDCODEC_HPP
@@ -55,6 +55,14 @@ enum class Param : uint16_t {
     YOKE_GENERAL = 0x010,
     PUMPS_THRESHOLD = 0x011,
     TEMPERATURE_POWERBOX = 0x012,
+    CPU_LOAD = 0x013,
+    ERROR_LOG = 0x014,
+    CRASH_DUMP = 0x015,
+    HEARTBEAT_EXT = 0x016,
+    COUNTER = 0x017,
+    TIME_SYNC = 0x018,
+    TIME_SYNC_FOLLOW_UP = 0x019,
+    TIME_SYNC_STATUS = 0x01A,
     UNKNOWN
 };
 
@@ -119,6 +127,24 @@ constexpr Message_t PUMPS_THRESHOLD = {2, Param::PUMPS_THRESHOLD,
 constexpr Message_t TEMPERATURE_POWERBOX = {5, Param::TEMPERATURE_POWERBOX,
                                             Group::DEFAULT};
 
+constexpr Message_t CPU_LOAD = {7, Param::CPU_LOAD, Group::DEFAULT};
+
+constexpr Message_t ERROR_LOG = {6, Param::ERROR_LOG, Group::DEFAULT};
+
+constexpr Message_t CRASH_DUMP = {6, Param::CRASH_DUMP, Group::DEFAULT};
+
+constexpr Message_t HEARTBEAT_EXT = {7, Param::HEARTBEAT_EXT, Group::DEFAULT};
+
+constexpr Message_t COUNTER = {7, Param::COUNTER, Group::DEFAULT};
+
+constexpr Message_t TIME_SYNC = {1, Param::TIME_SYNC, Group::DEFAULT};
+
+constexpr Message_t TIME_SYNC_FOLLOW_UP = {1, Param::TIME_SYNC_FOLLOW_UP,
+                                           Group::DEFAULT};
+
+constexpr Message_t TIME_SYNC_STATUS = {7, Param::TIME_SYNC_STATUS,
+                                        Group::DEFAULT};
+
 } // namespace Message
 
 } // namespace SBT::System::Comm::CAN_ID
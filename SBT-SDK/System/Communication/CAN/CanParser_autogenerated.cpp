@@ -1545,4 +1545,490 @@ void Pack_TEMPERATURE_POWERBOX(TEMPERATURE_POWERBOX_t* _m, uint8_t* _d)
 
 #endif // CANPARSER_USE_CANSTRUCT
 
+CPU_LOAD_t Unpack_CPU_LOAD(const uint8_t* _d)
+{
+    CPU_LOAD_t _m;
+    _m.idleLoad = (_d[0] & (0xFFU));
+    _m.taskCount = (_d[1] & (0xFFU));
+    _m.task1Number = (_d[2] & (0xFFU));
+    _m.task1Load = (_d[3] & (0xFFU));
+    _m.task2Number = (_d[4] & (0xFFU));
+    _m.task2Load = (_d[5] & (0xFFU));
+    _m.task3Number = (_d[6] & (0xFFU));
+    _m.task3Load = (_d[7] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < CPU_LOAD_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_CPU_LOAD_canparser(&_m.mon1, CPU_LOAD_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_CPU_LOAD(CPU_LOAD_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < CPU_LOAD_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->idleLoad & (0xFFU));
+    cframe->Data[1] |= (_m->taskCount & (0xFFU));
+    cframe->Data[2] |= (_m->task1Number & (0xFFU));
+    cframe->Data[3] |= (_m->task1Load & (0xFFU));
+    cframe->Data[4] |= (_m->task2Number & (0xFFU));
+    cframe->Data[5] |= (_m->task2Load & (0xFFU));
+    cframe->Data[6] |= (_m->task3Number & (0xFFU));
+    cframe->Data[7] |= (_m->task3Load & (0xFFU));
+
+    cframe->MsgId = CPU_LOAD_CANID;
+    cframe->DLC = CPU_LOAD_DLC;
+    cframe->IDE = CPU_LOAD_IDE;
+    return CPU_LOAD_CANID;
+}
+
+#else
+
+void Pack_CPU_LOAD(CPU_LOAD_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < CPU_LOAD_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->idleLoad & (0xFFU));
+    _d[1] |= (_m->taskCount & (0xFFU));
+    _d[2] |= (_m->task1Number & (0xFFU));
+    _d[3] |= (_m->task1Load & (0xFFU));
+    _d[4] |= (_m->task2Number & (0xFFU));
+    _d[5] |= (_m->task2Load & (0xFFU));
+    _d[6] |= (_m->task3Number & (0xFFU));
+    _d[7] |= (_m->task3Load & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+ERROR_LOG_t Unpack_ERROR_LOG(const uint8_t* _d)
+{
+    ERROR_LOG_t _m;
+    _m.module = (_d[0] & (0xFFU));
+    _m.code = (_d[1] & (0xFFU));
+    _m.line = ((_d[3] & (0xFFU)) << 8) | (_d[2] & (0xFFU));
+    _m.argument = ((_d[7] & (0xFFU)) << 24) | ((_d[6] & (0xFFU)) << 16) |
+                  ((_d[5] & (0xFFU)) << 8) | (_d[4] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < ERROR_LOG_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_ERROR_LOG_canparser(&_m.mon1, ERROR_LOG_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_ERROR_LOG(ERROR_LOG_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < ERROR_LOG_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->module & (0xFFU));
+    cframe->Data[1] |= (_m->code & (0xFFU));
+    cframe->Data[2] |= (_m->line & (0xFFU));
+    cframe->Data[3] |= ((_m->line >> 8) & (0xFFU));
+    cframe->Data[4] |= (_m->argument & (0xFFU));
+    cframe->Data[5] |= ((_m->argument >> 8) & (0xFFU));
+    cframe->Data[6] |= ((_m->argument >> 16) & (0xFFU));
+    cframe->Data[7] |= ((_m->argument >> 24) & (0xFFU));
+
+    cframe->MsgId = ERROR_LOG_CANID;
+    cframe->DLC = ERROR_LOG_DLC;
+    cframe->IDE = ERROR_LOG_IDE;
+    return ERROR_LOG_CANID;
+}
+
+#else
+
+void Pack_ERROR_LOG(ERROR_LOG_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < ERROR_LOG_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->module & (0xFFU));
+    _d[1] |= (_m->code & (0xFFU));
+    _d[2] |= (_m->line & (0xFFU));
+    _d[3] |= ((_m->line >> 8) & (0xFFU));
+    _d[4] |= (_m->argument & (0xFFU));
+    _d[5] |= ((_m->argument >> 8) & (0xFFU));
+    _d[6] |= ((_m->argument >> 16) & (0xFFU));
+    _d[7] |= ((_m->argument >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+CRASH_DUMP_t Unpack_CRASH_DUMP(const uint8_t* _d)
+{
+    CRASH_DUMP_t _m;
+    _m.index = (_d[0] & (0xFFU));
+    _m.count = (_d[1] & (0xFFU));
+    _m.value = ((_d[5] & (0xFFU)) << 24) | ((_d[4] & (0xFFU)) << 16) |
+               ((_d[3] & (0xFFU)) << 8) | (_d[2] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < CRASH_DUMP_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_CRASH_DUMP_canparser(&_m.mon1, CRASH_DUMP_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_CRASH_DUMP(CRASH_DUMP_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < CRASH_DUMP_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->index & (0xFFU));
+    cframe->Data[1] |= (_m->count & (0xFFU));
+    cframe->Data[2] |= (_m->value & (0xFFU));
+    cframe->Data[3] |= ((_m->value >> 8) & (0xFFU));
+    cframe->Data[4] |= ((_m->value >> 16) & (0xFFU));
+    cframe->Data[5] |= ((_m->value >> 24) & (0xFFU));
+
+    cframe->MsgId = CRASH_DUMP_CANID;
+    cframe->DLC = CRASH_DUMP_DLC;
+    cframe->IDE = CRASH_DUMP_IDE;
+    return CRASH_DUMP_CANID;
+}
+
+#else
+
+void Pack_CRASH_DUMP(CRASH_DUMP_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < CRASH_DUMP_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->index & (0xFFU));
+    _d[1] |= (_m->count & (0xFFU));
+    _d[2] |= (_m->value & (0xFFU));
+    _d[3] |= ((_m->value >> 8) & (0xFFU));
+    _d[4] |= ((_m->value >> 16) & (0xFFU));
+    _d[5] |= ((_m->value >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+HEARTBEAT_EXT_t Unpack_HEARTBEAT_EXT(const uint8_t* _d)
+{
+    HEARTBEAT_EXT_t _m;
+    _m.page = (_d[0] & (0xFFU));
+    _m.value8 = (_d[1] & (0xFFU));
+    _m.value16 = ((_d[3] & (0xFFU)) << 8) | (_d[2] & (0xFFU));
+    _m.value32 = ((_d[7] & (0xFFU)) << 24) | ((_d[6] & (0xFFU)) << 16) |
+                 ((_d[5] & (0xFFU)) << 8) | (_d[4] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < HEARTBEAT_EXT_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_HEARTBEAT_EXT_canparser(&_m.mon1, HEARTBEAT_EXT_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_HEARTBEAT_EXT(HEARTBEAT_EXT_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < HEARTBEAT_EXT_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->page & (0xFFU));
+    cframe->Data[1] |= (_m->value8 & (0xFFU));
+    cframe->Data[2] |= (_m->value16 & (0xFFU));
+    cframe->Data[3] |= ((_m->value16 >> 8) & (0xFFU));
+    cframe->Data[4] |= (_m->value32 & (0xFFU));
+    cframe->Data[5] |= ((_m->value32 >> 8) & (0xFFU));
+    cframe->Data[6] |= ((_m->value32 >> 16) & (0xFFU));
+    cframe->Data[7] |= ((_m->value32 >> 24) & (0xFFU));
+
+    cframe->MsgId = HEARTBEAT_EXT_CANID;
+    cframe->DLC = HEARTBEAT_EXT_DLC;
+    cframe->IDE = HEARTBEAT_EXT_IDE;
+    return HEARTBEAT_EXT_CANID;
+}
+
+#else
+
+void Pack_HEARTBEAT_EXT(HEARTBEAT_EXT_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < HEARTBEAT_EXT_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->page & (0xFFU));
+    _d[1] |= (_m->value8 & (0xFFU));
+    _d[2] |= (_m->value16 & (0xFFU));
+    _d[3] |= ((_m->value16 >> 8) & (0xFFU));
+    _d[4] |= (_m->value32 & (0xFFU));
+    _d[5] |= ((_m->value32 >> 8) & (0xFFU));
+    _d[6] |= ((_m->value32 >> 16) & (0xFFU));
+    _d[7] |= ((_m->value32 >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+COUNTER_t Unpack_COUNTER(const uint8_t* _d)
+{
+    COUNTER_t _m;
+    _m.index = (_d[0] & (0xFFU));
+    _m.count = (_d[1] & (0xFFU));
+    _m.id = ((_d[3] & (0xFFU)) << 8) | (_d[2] & (0xFFU));
+    _m.value = ((_d[7] & (0xFFU)) << 24) | ((_d[6] & (0xFFU)) << 16) |
+               ((_d[5] & (0xFFU)) << 8) | (_d[4] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < COUNTER_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_COUNTER_canparser(&_m.mon1, COUNTER_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_COUNTER(COUNTER_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < COUNTER_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->index & (0xFFU));
+    cframe->Data[1] |= (_m->count & (0xFFU));
+    cframe->Data[2] |= (_m->id & (0xFFU));
+    cframe->Data[3] |= ((_m->id >> 8) & (0xFFU));
+    cframe->Data[4] |= (_m->value & (0xFFU));
+    cframe->Data[5] |= ((_m->value >> 8) & (0xFFU));
+    cframe->Data[6] |= ((_m->value >> 16) & (0xFFU));
+    cframe->Data[7] |= ((_m->value >> 24) & (0xFFU));
+
+    cframe->MsgId = COUNTER_CANID;
+    cframe->DLC = COUNTER_DLC;
+    cframe->IDE = COUNTER_IDE;
+    return COUNTER_CANID;
+}
+
+#else
+
+void Pack_COUNTER(COUNTER_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < COUNTER_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->index & (0xFFU));
+    _d[1] |= (_m->count & (0xFFU));
+    _d[2] |= (_m->id & (0xFFU));
+    _d[3] |= ((_m->id >> 8) & (0xFFU));
+    _d[4] |= (_m->value & (0xFFU));
+    _d[5] |= ((_m->value >> 8) & (0xFFU));
+    _d[6] |= ((_m->value >> 16) & (0xFFU));
+    _d[7] |= ((_m->value >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+TIME_SYNC_t Unpack_TIME_SYNC(const uint8_t* _d)
+{
+    TIME_SYNC_t _m;
+    _m.sequence = (_d[0] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < TIME_SYNC_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_TIME_SYNC_canparser(&_m.mon1, TIME_SYNC_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_TIME_SYNC(TIME_SYNC_t* _m, __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->sequence & (0xFFU));
+
+    cframe->MsgId = TIME_SYNC_CANID;
+    cframe->DLC = TIME_SYNC_DLC;
+    cframe->IDE = TIME_SYNC_IDE;
+    return TIME_SYNC_CANID;
+}
+
+#else
+
+void Pack_TIME_SYNC(TIME_SYNC_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->sequence & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+TIME_SYNC_FOLLOW_UP_t Unpack_TIME_SYNC_FOLLOW_UP(const uint8_t* _d)
+{
+    TIME_SYNC_FOLLOW_UP_t _m;
+    _m.sequence = (_d[0] & (0xFFU));
+    _m.microseconds = ((_d[3] & (0xFFU)) << 16) | ((_d[2] & (0xFFU)) << 8) |
+                      (_d[1] & (0xFFU));
+    _m.seconds = ((_d[7] & (0xFFU)) << 24) | ((_d[6] & (0xFFU)) << 16) |
+                 ((_d[5] & (0xFFU)) << 8) | (_d[4] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < TIME_SYNC_FOLLOW_UP_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_TIME_SYNC_FOLLOW_UP_canparser(&_m.mon1, TIME_SYNC_FOLLOW_UP_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_TIME_SYNC_FOLLOW_UP(TIME_SYNC_FOLLOW_UP_t* _m,
+                                  __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_FOLLOW_UP_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->sequence & (0xFFU));
+    cframe->Data[1] |= (_m->microseconds & (0xFFU));
+    cframe->Data[2] |= ((_m->microseconds >> 8) & (0xFFU));
+    cframe->Data[3] |= ((_m->microseconds >> 16) & (0xFFU));
+    cframe->Data[4] |= (_m->seconds & (0xFFU));
+    cframe->Data[5] |= ((_m->seconds >> 8) & (0xFFU));
+    cframe->Data[6] |= ((_m->seconds >> 16) & (0xFFU));
+    cframe->Data[7] |= ((_m->seconds >> 24) & (0xFFU));
+
+    cframe->MsgId = TIME_SYNC_FOLLOW_UP_CANID;
+    cframe->DLC = TIME_SYNC_FOLLOW_UP_DLC;
+    cframe->IDE = TIME_SYNC_FOLLOW_UP_IDE;
+    return TIME_SYNC_FOLLOW_UP_CANID;
+}
+
+#else
+
+void Pack_TIME_SYNC_FOLLOW_UP(TIME_SYNC_FOLLOW_UP_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_FOLLOW_UP_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->sequence & (0xFFU));
+    _d[1] |= (_m->microseconds & (0xFFU));
+    _d[2] |= ((_m->microseconds >> 8) & (0xFFU));
+    _d[3] |= ((_m->microseconds >> 16) & (0xFFU));
+    _d[4] |= (_m->seconds & (0xFFU));
+    _d[5] |= ((_m->seconds >> 8) & (0xFFU));
+    _d[6] |= ((_m->seconds >> 16) & (0xFFU));
+    _d[7] |= ((_m->seconds >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
+TIME_SYNC_STATUS_t Unpack_TIME_SYNC_STATUS(const uint8_t* _d)
+{
+    TIME_SYNC_STATUS_t _m;
+    _m.state = (_d[0] & (0xFFU));
+    _m.master = (_d[1] & (0xFFU));
+    _m.drift = __ext_sig__((((_d[3] & (0xFFU)) << 8) | (_d[2] & (0xFFU))), 16);
+    _m.error = ((_d[7] & (0xFFU)) << 24) | ((_d[6] & (0xFFU)) << 16) |
+               ((_d[5] & (0xFFU)) << 8) | (_d[4] & (0xFFU));
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+    _m.mon1.dlc_error = (dlc_ < TIME_SYNC_STATUS_DLC);
+    _m.mon1.last_cycle = GetSystemTick();
+    _m.mon1.frame_cnt++;
+
+    FMon_TIME_SYNC_STATUS_canparser(&_m.mon1, TIME_SYNC_STATUS_CANID);
+#endif // CANPARSER_USE_DIAG_MONITORS
+
+    return _m;
+}
+
+#ifdef CANPARSER_USE_CANSTRUCT
+
+uint32_t Pack_TIME_SYNC_STATUS(TIME_SYNC_STATUS_t* _m,
+                               __CoderDbcCanFrame_t__* cframe)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_STATUS_DLC) && (i < 8); cframe->Data[i++] = 0)
+        ;
+
+    cframe->Data[0] |= (_m->state & (0xFFU));
+    cframe->Data[1] |= (_m->master & (0xFFU));
+    cframe->Data[2] |= (_m->drift & (0xFFU));
+    cframe->Data[3] |= ((_m->drift >> 8) & (0xFFU));
+    cframe->Data[4] |= (_m->error & (0xFFU));
+    cframe->Data[5] |= ((_m->error >> 8) & (0xFFU));
+    cframe->Data[6] |= ((_m->error >> 16) & (0xFFU));
+    cframe->Data[7] |= ((_m->error >> 24) & (0xFFU));
+
+    cframe->MsgId = TIME_SYNC_STATUS_CANID;
+    cframe->DLC = TIME_SYNC_STATUS_DLC;
+    cframe->IDE = TIME_SYNC_STATUS_IDE;
+    return TIME_SYNC_STATUS_CANID;
+}
+
+#else
+
+void Pack_TIME_SYNC_STATUS(TIME_SYNC_STATUS_t* _m, uint8_t* _d)
+{
+    uint8_t i;
+    for(i = 0; (i < TIME_SYNC_STATUS_DLC) && (i < 8); _d[i++] = 0)
+        ;
+
+    _d[0] |= (_m->state & (0xFFU));
+    _d[1] |= (_m->master & (0xFFU));
+    _d[2] |= (_m->drift & (0xFFU));
+    _d[3] |= ((_m->drift >> 8) & (0xFFU));
+    _d[4] |= (_m->error & (0xFFU));
+    _d[5] |= ((_m->error >> 8) & (0xFFU));
+    _d[6] |= ((_m->error >> 16) & (0xFFU));
+    _d[7] |= ((_m->error >> 24) & (0xFFU));
+}
+
+#endif // CANPARSER_USE_CANSTRUCT
+
 } // namespace SBT::System::Comm
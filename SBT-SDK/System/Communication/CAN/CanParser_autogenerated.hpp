@@ -1232,6 +1232,282 @@ struct TEMPERATURE_POWERBOX_t : CAN_STRUCT_SAMPLE_t {
 #endif // CANPARSER_USE_DIAG_MONITORS
 };
 
+// def @CPU_LOAD CAN Message (19   0x13)
+#define CPU_LOAD_IDE   (0U)
+#define CPU_LOAD_DLC   (8U)
+#define CPU_LOAD_CANID (0x13)
+
+struct CPU_LOAD_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t idleLoad; //      Bits= 8 Unit:'%'
+
+    uint8_t taskCount; //      Bits= 8
+
+    uint8_t task1Number; //      Bits= 8
+
+    uint8_t task1Load; //      Bits= 8 Unit:'%'
+
+    uint8_t task2Number; //      Bits= 8
+
+    uint8_t task2Load; //      Bits= 8 Unit:'%'
+
+    uint8_t task3Number; //      Bits= 8
+
+    uint8_t task3Load; //      Bits= 8 Unit:'%'
+
+#else
+
+    uint8_t idleLoad; //      Bits= 8 Unit:'%'
+
+    uint8_t taskCount; //      Bits= 8
+
+    uint8_t task1Number; //      Bits= 8
+
+    uint8_t task1Load; //      Bits= 8 Unit:'%'
+
+    uint8_t task2Number; //      Bits= 8
+
+    uint8_t task2Load; //      Bits= 8 Unit:'%'
+
+    uint8_t task3Number; //      Bits= 8
+
+    uint8_t task3Load; //      Bits= 8 Unit:'%'
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @ERROR_LOG CAN Message (20   0x14)
+#define ERROR_LOG_IDE   (0U)
+#define ERROR_LOG_DLC   (8U)
+#define ERROR_LOG_CANID (0x14)
+
+struct ERROR_LOG_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t module; //      Bits= 8
+
+    uint8_t code; //      Bits= 8
+
+    uint16_t line; //      Bits=16
+
+    uint32_t argument; //      Bits=32
+
+#else
+
+    uint8_t module; //      Bits= 8
+
+    uint8_t code; //      Bits= 8
+
+    uint16_t line; //      Bits=16
+
+    uint32_t argument; //      Bits=32
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @CRASH_DUMP CAN Message (21   0x15)
+#define CRASH_DUMP_IDE   (0U)
+#define CRASH_DUMP_DLC   (8U)
+#define CRASH_DUMP_CANID (0x15)
+
+struct CRASH_DUMP_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t index; //      Bits= 8
+
+    uint8_t count; //      Bits= 8
+
+    uint32_t value; //      Bits=32
+
+#else
+
+    uint8_t index; //      Bits= 8
+
+    uint8_t count; //      Bits= 8
+
+    uint32_t value; //      Bits=32
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @HEARTBEAT_EXT CAN Message (22   0x16)
+#define HEARTBEAT_EXT_IDE   (0U)
+#define HEARTBEAT_EXT_DLC   (8U)
+#define HEARTBEAT_EXT_CANID (0x16)
+
+struct HEARTBEAT_EXT_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t page; //      Bits= 8
+
+    uint8_t value8; //      Bits= 8
+
+    uint16_t value16; //      Bits=16
+
+    uint32_t value32; //      Bits=32
+
+#else
+
+    uint8_t page; //      Bits= 8
+
+    uint8_t value8; //      Bits= 8
+
+    uint16_t value16; //      Bits=16
+
+    uint32_t value32; //      Bits=32
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @COUNTER CAN Message (23   0x17)
+#define COUNTER_IDE   (0U)
+#define COUNTER_DLC   (8U)
+#define COUNTER_CANID (0x17)
+
+struct COUNTER_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t index; //      Bits= 8
+
+    uint8_t count; //      Bits= 8
+
+    uint16_t id; //      Bits=16
+
+    uint32_t value; //      Bits=32
+
+#else
+
+    uint8_t index; //      Bits= 8
+
+    uint8_t count; //      Bits= 8
+
+    uint16_t id; //      Bits=16
+
+    uint32_t value; //      Bits=32
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @TIME_SYNC CAN Message (24   0x18)
+#define TIME_SYNC_IDE   (0U)
+#define TIME_SYNC_DLC   (8U)
+#define TIME_SYNC_CANID (0x18)
+
+struct TIME_SYNC_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t sequence; //      Bits= 8
+
+#else
+
+    uint8_t sequence; //      Bits= 8
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @TIME_SYNC_FOLLOW_UP CAN Message (25   0x19)
+#define TIME_SYNC_FOLLOW_UP_IDE   (0U)
+#define TIME_SYNC_FOLLOW_UP_DLC   (8U)
+#define TIME_SYNC_FOLLOW_UP_CANID (0x19)
+
+struct TIME_SYNC_FOLLOW_UP_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t sequence; //      Bits= 8
+
+    uint32_t microseconds; //      Bits=24 Unit:'us'
+
+    uint32_t seconds; //      Bits=32 Unit:'s'
+
+#else
+
+    uint8_t sequence; //      Bits= 8
+
+    uint32_t microseconds; //      Bits=24 Unit:'us'
+
+    uint32_t seconds; //      Bits=32 Unit:'s'
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
+// def @TIME_SYNC_STATUS CAN Message (26   0x1A)
+#define TIME_SYNC_STATUS_IDE   (0U)
+#define TIME_SYNC_STATUS_DLC   (8U)
+#define TIME_SYNC_STATUS_CANID (0x1A)
+
+struct TIME_SYNC_STATUS_t : CAN_STRUCT_SAMPLE_t {
+#ifdef CANPARSER_USE_BITS_SIGNAL
+
+    uint8_t state; //      Bits= 8
+
+    uint8_t master; //      Bits= 8
+
+    int16_t drift; //  [-] Bits=16 Unit:'10ppb'
+
+    int32_t error; //  [-] Bits=32 Unit:'us'
+
+#else
+
+    uint8_t state; //      Bits= 8
+
+    uint8_t master; //      Bits= 8
+
+    int16_t drift; //  [-] Bits=16 Unit:'10ppb'
+
+    int32_t error; //  [-] Bits=32 Unit:'us'
+
+#endif // CANPARSER_USE_BITS_SIGNAL
+
+#ifdef CANPARSER_USE_DIAG_MONITORS
+
+    FrameMonitor_t mon1;
+
+#endif // CANPARSER_USE_DIAG_MONITORS
+};
+
 // Function signatures
 
 /**
@@ -1556,4 +1832,144 @@ void Pack_TEMPERATURE_POWERBOX(TEMPERATURE_POWERBOX_t* _m,
 void Pack_TEMPERATURE_POWERBOX(TEMPERATURE_POWERBOX_t* _m, uint8_t* _d);
 #endif // CANPARSER_USE_CANSTRUCT
 
+/**
+ * @brief Unpacks raw CAN frame payload into CPU_LOAD_t struct
+ * @param _d pointer to payload to unpack
+ * @return CPU_LOAD_t unpacked object
+ */
+[[nodiscard]] CPU_LOAD_t Unpack_CPU_LOAD(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_CPU_LOAD(CPU_LOAD_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs CPU_LOAD_t object into raw 8-byte long payload
+ * @param _m pointer to CPU_LOAD_t object to pack
+ * @param _d pointer to payload, where CPU_LOAD_t object will be packed
+ */
+void Pack_CPU_LOAD(CPU_LOAD_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into ERROR_LOG_t struct
+ * @param _d pointer to payload to unpack
+ * @return ERROR_LOG_t unpacked object
+ */
+[[nodiscard]] ERROR_LOG_t Unpack_ERROR_LOG(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_ERROR_LOG(ERROR_LOG_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs ERROR_LOG_t object into raw 8-byte long payload
+ * @param _m pointer to ERROR_LOG_t object to pack
+ * @param _d pointer to payload, where ERROR_LOG_t object will be packed
+ */
+void Pack_ERROR_LOG(ERROR_LOG_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into CRASH_DUMP_t struct
+ * @param _d pointer to payload to unpack
+ * @return CRASH_DUMP_t unpacked object
+ */
+[[nodiscard]] CRASH_DUMP_t Unpack_CRASH_DUMP(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_CRASH_DUMP(CRASH_DUMP_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs CRASH_DUMP_t object into raw 8-byte long payload
+ * @param _m pointer to CRASH_DUMP_t object to pack
+ * @param _d pointer to payload, where CRASH_DUMP_t object will be packed
+ */
+void Pack_CRASH_DUMP(CRASH_DUMP_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into HEARTBEAT_EXT_t struct
+ * @param _d pointer to payload to unpack
+ * @return HEARTBEAT_EXT_t unpacked object
+ */
+[[nodiscard]] HEARTBEAT_EXT_t Unpack_HEARTBEAT_EXT(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_HEARTBEAT_EXT(HEARTBEAT_EXT_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs HEARTBEAT_EXT_t object into raw 8-byte long payload
+ * @param _m pointer to HEARTBEAT_EXT_t object to pack
+ * @param _d pointer to payload, where HEARTBEAT_EXT_t object will be packed
+ */
+void Pack_HEARTBEAT_EXT(HEARTBEAT_EXT_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into COUNTER_t struct
+ * @param _d pointer to payload to unpack
+ * @return COUNTER_t unpacked object
+ */
+[[nodiscard]] COUNTER_t Unpack_COUNTER(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_COUNTER(COUNTER_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs COUNTER_t object into raw 8-byte long payload
+ * @param _m pointer to COUNTER_t object to pack
+ * @param _d pointer to payload, where COUNTER_t object will be packed
+ */
+void Pack_COUNTER(COUNTER_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into TIME_SYNC_t struct
+ * @param _d pointer to payload to unpack
+ * @return TIME_SYNC_t unpacked object
+ */
+[[nodiscard]] TIME_SYNC_t Unpack_TIME_SYNC(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_TIME_SYNC(TIME_SYNC_t* _m, __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs TIME_SYNC_t object into raw 8-byte long payload
+ * @param _m pointer to TIME_SYNC_t object to pack
+ * @param _d pointer to payload, where TIME_SYNC_t object will be packed
+ */
+void Pack_TIME_SYNC(TIME_SYNC_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into TIME_SYNC_FOLLOW_UP_t struct
+ * @param _d pointer to payload to unpack
+ * @return TIME_SYNC_FOLLOW_UP_t unpacked object
+ */
+[[nodiscard]] TIME_SYNC_FOLLOW_UP_t
+Unpack_TIME_SYNC_FOLLOW_UP(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_TIME_SYNC_FOLLOW_UP(TIME_SYNC_FOLLOW_UP_t* _m,
+                              __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs TIME_SYNC_FOLLOW_UP_t object into raw 8-byte long payload
+ * @param _m pointer to TIME_SYNC_FOLLOW_UP_t object to pack
+ * @param _d pointer to payload, where TIME_SYNC_FOLLOW_UP_t object will be
+ * packed
+ */
+void Pack_TIME_SYNC_FOLLOW_UP(TIME_SYNC_FOLLOW_UP_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
+/**
+ * @brief Unpacks raw CAN frame payload into TIME_SYNC_STATUS_t struct
+ * @param _d pointer to payload to unpack
+ * @return TIME_SYNC_STATUS_t unpacked object
+ */
+[[nodiscard]] TIME_SYNC_STATUS_t Unpack_TIME_SYNC_STATUS(const uint8_t* _d);
+#ifdef CANPARSER_USE_CANSTRUCT
+void Pack_TIME_SYNC_STATUS(TIME_SYNC_STATUS_t* _m,
+                           __CoderDbcCanFrame_t__* cframe);
+#else
+/**
+ * @brief Packs TIME_SYNC_STATUS_t object into raw 8-byte long payload
+ * @param _m pointer to TIME_SYNC_STATUS_t object to pack
+ * @param _d pointer to payload, where TIME_SYNC_STATUS_t object will be packed
+ */
+void Pack_TIME_SYNC_STATUS(TIME_SYNC_STATUS_t* _m, uint8_t* _d);
+#endif // CANPARSER_USE_CANSTRUCT
+
 } // namespace SBT::System::Comm
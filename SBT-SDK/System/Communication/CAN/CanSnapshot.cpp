@@ -0,0 +1,13 @@
+#include "CanSnapshot.hpp"
+
+namespace SBT::System::Comm {
+
+// Compiled once here, so errors in the templates show up in every build with
+// SBT_CAN_SNAPSHOT, not only in projects which use them
+template class SnapshotAssembler<LIFEPO4_CELLS_SNAPSHOT_t>;
+template class SnapshotAssembler<GEODETIC_POSITION_SNAPSHOT_t>;
+
+template void SendSnapshot(LIFEPO4_CELLS_SNAPSHOT_t&, CAN_ID::Source);
+template void SendSnapshot(GEODETIC_POSITION_SNAPSHOT_t&, CAN_ID::Source);
+
+} // namespace SBT::System::Comm
@@ -0,0 +1,241 @@
+#ifndef SBT_SYSTEM_COMM_CAN_SNAPSHOT_HPP
+#define SBT_SYSTEM_COMM_CAN_SNAPSHOT_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "CanParser_autogenerated.hpp"
+#include "CommCAN.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef SBT_CAN_SNAPSHOT
+#error "CanSnapshot.hpp requires the SDK built with SBT_CAN_SNAPSHOT"
+#endif
+
+/**
+ * @brief Multi-frame snapshots - values sampled at one instant but spread over
+ * several CAN messages (e.g. cell voltages in LIFEPO4_CELLS_1.._3).
+ *
+ * Sender packs the whole snapshot struct with SendSnapshot(). All frames get
+ * the same snapshot counter (bits 17..14 of extended ID, see CanIDCodec.hpp).
+ * Receiver feeds frames to a SnapshotAssembler, which publishes the snapshot
+ * only after all its parts with the same counter have arrived, so consumers
+ * never see parts from different sampling instants.
+ *
+ * Example (receiver):
+ * SnapshotAssembler<LIFEPO4_CELLS_SNAPSHOT_t> cells;
+ * CAN::AddFilter(CAN::Filter(CAN_ID::Source::LIFEPO4_1,
+ *                            CAN_ID::Group::LIFEPO4_DATA),
+ *                &cells, &SnapshotAssembler<LIFEPO4_CELLS_SNAPSHOT_t>::Add);
+ * ...
+ * LIFEPO4_CELLS_SNAPSHOT_t latest;
+ * if(cells.Get(latest)) ...
+ *
+ * New snapshot types need a struct and a SnapshotTraits specialization.
+ *
+ * Available when the SDK is built with SBT_CAN_SNAPSHOT, which also enables
+ * CAN::SendSnapshot(). Assemblers of the snapshot types below are
+ * instantiated in CanSnapshot.cpp.
+ */
+
+namespace SBT::System::Comm {
+
+struct LIFEPO4_CELLS_SNAPSHOT_t {
+    LIFEPO4_CELLS_1_t cells1;
+    LIFEPO4_CELLS_2_t cells2;
+    LIFEPO4_CELLS_3_t cells3;
+};
+
+struct GEODETIC_POSITION_SNAPSHOT_t {
+    GEODETIC_POSITION_1_t position1;
+    GEODETIC_POSITION_2_t position2;
+};
+
+/**
+ * @brief Describes parts of a snapshot type:
+ * - static constexpr size_t partCount
+ * - static constexpr CAN_ID::Message_t messages[partCount]
+ * - static void Pack(Snapshot&, uint8_t (&data)[partCount][8])
+ * - static void Unpack(Snapshot&, size_t part, const uint8_t* data)
+ */
+template <typename Snapshot> struct SnapshotTraits;
+
+template <> struct SnapshotTraits<LIFEPO4_CELLS_SNAPSHOT_t> {
+    static constexpr size_t partCount = 3;
+    static constexpr CAN_ID::Message_t messages[partCount] = {
+        CAN_ID::Message::LIFEPO4_CELLS_1, CAN_ID::Message::LIFEPO4_CELLS_2,
+        CAN_ID::Message::LIFEPO4_CELLS_3};
+
+    static void Pack(LIFEPO4_CELLS_SNAPSHOT_t& snapshot,
+                     uint8_t (&data)[partCount][8])
+    {
+        Pack_LIFEPO4_CELLS_1(&snapshot.cells1, data[0]);
+        Pack_LIFEPO4_CELLS_2(&snapshot.cells2, data[1]);
+        Pack_LIFEPO4_CELLS_3(&snapshot.cells3, data[2]);
+    }
+
+    static void Unpack(LIFEPO4_CELLS_SNAPSHOT_t& snapshot, size_t part,
+                       const uint8_t* data)
+    {
+        if(part == 0)
+            snapshot.cells1 = Unpack_LIFEPO4_CELLS_1(data);
+        else if(part == 1)
+            snapshot.cells2 = Unpack_LIFEPO4_CELLS_2(data);
+        else
+            snapshot.cells3 = Unpack_LIFEPO4_CELLS_3(data);
+    }
+};
+
+template <> struct SnapshotTraits<GEODETIC_POSITION_SNAPSHOT_t> {
+    static constexpr size_t partCount = 2;
+    static constexpr CAN_ID::Message_t messages[partCount] = {
+        CAN_ID::Message::GEODETIC_POSITION_1,
+        CAN_ID::Message::GEODETIC_POSITION_2};
+
+    static void Pack(GEODETIC_POSITION_SNAPSHOT_t& snapshot,
+                     uint8_t (&data)[partCount][8])
+    {
+        Pack_GEODETIC_POSITION_1(&snapshot.position1, data[0]);
+        Pack_GEODETIC_POSITION_2(&snapshot.position2, data[1]);
+    }
+
+    static void Unpack(GEODETIC_POSITION_SNAPSHOT_t& snapshot, size_t part,
+                       const uint8_t* data)
+    {
+        if(part == 0)
+            snapshot.position1 = Unpack_GEODETIC_POSITION_1(data);
+        else
+            snapshot.position2 = Unpack_GEODETIC_POSITION_2(data);
+    }
+};
+
+/**
+ * @brief Pack snapshot and add all its frames to transmit messages queue
+ * @param snapshot snapshot to send
+ * @param sID Source ID of transmitting messages
+ */
+template <typename Snapshot>
+void SendSnapshot(Snapshot& snapshot,
+                  CAN_ID::Source sID = CAN::GetDefaultSourceID())
+{
+    using Traits = SnapshotTraits<Snapshot>;
+
+    uint8_t data[Traits::partCount][8]{};
+    Traits::Pack(snapshot, data);
+    CAN::SendSnapshot(sID, Traits::messages, data, Traits::partCount);
+}
+
+/**
+ * @brief Assembles snapshots of one source from received frames.
+ * Add() has to be called from one task (e.g. CanReceiver callbacks), Get()
+ * may be called from any task.
+ */
+template <typename Snapshot> class SnapshotAssembler {
+    using Traits = SnapshotTraits<Snapshot>;
+    static constexpr uint32_t allParts = (1U << Traits::partCount) - 1;
+
+public:
+    struct Statistics {
+        // Snapshots published
+        uint32_t completed;
+        // Assemblies dropped because a part with another counter arrived
+        // before all parts were collected (lost or reordered frames)
+        uint32_t incomplete;
+        // Assemblies dropped because a part arrived twice with the same
+        // counter - publishing them would mix two sampling instants
+        uint32_t torn;
+        // Parts without snapshot counter (sent with ordinary CAN::Send)
+        uint32_t unsynchronized;
+    };
+
+    /**
+     * @brief Pass received frame to the assembler. Frames which are not a
+     * part of this snapshot type are ignored.
+     */
+    void Add(CAN::RxMessage mess)
+    {
+        const auto param = mess.GetMessageID().paramID;
+        size_t part = 0;
+        while(part < Traits::partCount &&
+              Traits::messages[part].paramID != param)
+            part++;
+        if(part == Traits::partCount)
+            return;
+
+        const uint8_t counter = mess.GetSnapshot();
+        if(counter == 0) {
+            stats.unsynchronized++;
+            return;
+        }
+
+        const uint32_t partBit = 1U << part;
+        if(receivedParts != 0) {
+            if(counter != assemblyCounter) {
+                stats.incomplete++;
+                receivedParts = 0;
+            }
+            else if(receivedParts & partBit) {
+                stats.torn++;
+                receivedParts = 0;
+            }
+        }
+
+        assemblyCounter = counter;
+        receivedParts |= partBit;
+        Traits::Unpack(assembly, part, mess.GetPayload());
+
+        if(receivedParts == allParts) {
+            taskENTER_CRITICAL();
+            published = assembly;
+            publishedCounter = counter;
+            stats.completed++;
+            taskEXIT_CRITICAL();
+            receivedParts = 0;
+        }
+    }
+
+    /**
+     * @brief Copy latest complete snapshot
+     * @param snapshot destination
+     * @param counter if not nullptr, set to snapshot counter of the copy
+     * @return false if no snapshot was completed yet
+     */
+    bool Get(Snapshot& snapshot, uint8_t* counter = nullptr) const
+    {
+        taskENTER_CRITICAL();
+        const bool available = stats.completed != 0;
+        snapshot = published;
+        if(counter != nullptr)
+            *counter = publishedCounter;
+        taskEXIT_CRITICAL();
+        return available;
+    }
+
+    /**
+     * @brief Copy of assembler counters
+     */
+    Statistics GetStatistics() const
+    {
+        taskENTER_CRITICAL();
+        const Statistics copy = stats;
+        taskEXIT_CRITICAL();
+        return copy;
+    }
+
+private:
+    // Snapshot being assembled, touched only by Add()
+    Snapshot assembly{};
+    uint32_t receivedParts = 0;
+    uint8_t assemblyCounter = 0;
+
+    // Latest complete snapshot, guarded by critical section
+    Snapshot published{};
+    uint8_t publishedCounter = 0;
+    Statistics stats{};
+};
+
+} // namespace SBT::System::Comm
+
+#endif // SBT_SYSTEM_COMM_CAN_SNAPSHOT_HPP
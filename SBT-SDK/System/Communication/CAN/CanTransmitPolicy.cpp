@@ -0,0 +1,30 @@
+#include "CanTransmitPolicy.hpp"
+
+namespace SBT::System::Comm {
+
+TransmitPolicyBase::Statistics TransmitPolicyBase::total{};
+
+TransmitPolicyBase::Statistics TransmitPolicyBase::GetTotalStatistics()
+{
+    taskENTER_CRITICAL();
+    const Statistics copy = total;
+    taskEXIT_CRITICAL();
+    return copy;
+}
+
+void TransmitPolicyBase::Count(Statistics& stats, bool sent)
+{
+    // Policies may be used from several tasks, counters are read by Heartbeat
+    taskENTER_CRITICAL();
+    if(sent) {
+        stats.sent++;
+        total.sent++;
+    }
+    else {
+        stats.suppressed++;
+        total.suppressed++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+} // namespace SBT::System::Comm
@@ -0,0 +1,205 @@
+#ifndef SBT_SYSTEM_COMM_CAN_TRANSMITPOLICY_HPP
+#define SBT_SYSTEM_COMM_CAN_TRANSMITPOLICY_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "CanParser_autogenerated.hpp"
+#include "CommCAN.hpp"
+#include "Time.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef SBT_CAN_TRANSMIT_POLICY
+#error "CanTransmitPolicy.hpp requires SBT_CAN_TRANSMIT_POLICY"
+#endif
+#ifdef SBT_CAN_SENDER_DISABLE
+#error "SBT_CAN_TRANSMIT_POLICY sends through CanSender, it cannot be disabled"
+#endif
+
+/**
+ * @brief Send-on-delta transmission of telemetry messages.
+ *
+ * A TransmitPolicy compares a message with the last sent one and transmits it
+ * only if any signal moved by more than its deadband, or maxInterval passed
+ * since the last transmission (periodic refresh, so receivers can still detect
+ * a dead node). Never more often than once per minInterval. Suppressed messages
+ * are not packed and do not enter the CanSender queue.
+ *
+ * Available when the SDK is built with SBT_CAN_TRANSMIT_POLICY. Heartbeat then
+ * reports the frames suppressed by all policies and the achieved reduction on
+ * the TransmitPolicy page of HEARTBEAT_EXT.
+ *
+ * Example:
+ * static TransmitPolicy<TEMPERATURE_POWERBOX_t, 2> temperaturePolicy(
+ *     CAN_ID::Message::TEMPERATURE_POWERBOX, Pack_TEMPERATURE_POWERBOX,
+ *     {SBT_TX_SIGNAL(TEMPERATURE_POWERBOX_t, temperature1, 2),
+ *      SBT_TX_SIGNAL(TEMPERATURE_POWERBOX_t, temperature2, 2)},
+ *     100, 5000);
+ * ...
+ * temperaturePolicy.Send(temperatures);
+ */
+
+/**
+ * @brief Signal description for TransmitPolicy
+ * @param MESSAGE_T generated message struct, e.g. TEMPERATURE_POWERBOX_t
+ * @param SIGNAL signal (field) name
+ * @param DEADBAND largest change of raw value which does not trigger sending
+ */
+#define SBT_TX_SIGNAL(MESSAGE_T, SIGNAL, DEADBAND)                             \
+    {                                                                          \
+        [](const MESSAGE_T& m) { return static_cast<int64_t>(m.SIGNAL); },     \
+            DEADBAND                                                           \
+    }
+
+namespace SBT::System::Comm {
+
+/**
+ * @brief Counters shared by all policies, to report achieved bus load
+ * reduction
+ */
+class TransmitPolicyBase {
+public:
+    struct Statistics {
+        uint32_t sent;
+        uint32_t suppressed;
+
+        /**
+         * @brief Suppressed frames in percent of all frames offered
+         */
+        [[nodiscard]] uint8_t GetReductionPercent() const
+        {
+            const uint64_t total = static_cast<uint64_t>(sent) + suppressed;
+            return total == 0 ? 0
+                              : static_cast<uint8_t>(
+                                    static_cast<uint64_t>(suppressed) * 100 /
+                                    total);
+        }
+    };
+
+    /**
+     * @brief Sum of counters of all policies
+     */
+    static Statistics GetTotalStatistics();
+
+protected:
+    // Has to be called from a task, not from an interrupt
+    static void Count(Statistics& stats, bool sent);
+
+private:
+    static Statistics total;
+};
+
+/**
+ * @brief Transmission policy of one message type from one source
+ * @tparam Message generated message struct, e.g. TEMPERATURE_POWERBOX_t
+ * @tparam SignalCount number of signals compared with the last sent message
+ */
+template <typename Message, size_t SignalCount>
+class TransmitPolicy : public TransmitPolicyBase {
+public:
+    struct Signal {
+        int64_t (*get)(const Message&);
+        uint32_t deadband;
+    };
+
+    /**
+     * @param mID Message ID of transmitted message
+     * @param pack generated Pack_* function of the message
+     * @param signals signals with deadbands, see SBT_TX_SIGNAL
+     * @param minInterval minimal time between transmissions in ms
+     * @param maxInterval time in ms after which message is sent even if it did
+     * not change, 0 to never refresh
+     */
+    TransmitPolicy(CAN_ID::Message_t mID, void (*pack)(Message*, uint8_t*),
+                   const Signal (&signals)[SignalCount], uint32_t minInterval,
+                   uint32_t maxInterval)
+        : messageID{mID}, pack{pack}, minInterval{minInterval},
+          maxInterval{maxInterval}
+    {
+        for(size_t i = 0; i < SignalCount; i++)
+            this->signals[i] = signals[i];
+    }
+
+    /**
+     * @brief Check if message should be sent now
+     * @param message message to check
+     * @return true if message differs enough or refresh is due
+     */
+    [[nodiscard]] bool ShouldSend(const Message& message) const
+    {
+        if(!sentOnce || forceRefresh)
+            return true;
+
+        const uint32_t elapsed = Time::GetUpTime() - lastSentTime;
+        if(elapsed < minInterval)
+            return false;
+        if(maxInterval != 0 && elapsed >= maxInterval)
+            return true;
+
+        for(size_t i = 0; i < SignalCount; i++) {
+            const int64_t delta = signals[i].get(message) - lastSent[i];
+            if(delta > signals[i].deadband || -delta > signals[i].deadband)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pack and send message if the policy allows it
+     * @param message message to send
+     * @param sID Source ID of transmitting message
+     * @return true if message was added to transmit messages queue
+     */
+    bool Send(Message& message,
+              CAN_ID::Source sID = CAN::GetDefaultSourceID())
+    {
+        const bool send = ShouldSend(message);
+        Count(stats, send);
+        if(!send)
+            return false;
+
+        for(size_t i = 0; i < SignalCount; i++)
+            lastSent[i] = signals[i].get(message);
+        lastSentTime = Time::GetUpTime();
+        sentOnce = true;
+        forceRefresh = false;
+
+        uint8_t data[8]{};
+        pack(&message, data);
+        CAN::Send(sID, messageID, data);
+        return true;
+    }
+
+    /**
+     * @brief Send next message regardless of deadbands and intervals, e.g.
+     * after a receiver requested current state
+     */
+    void ForceRefresh() { forceRefresh = true; }
+
+    [[nodiscard]] Statistics GetStatistics() const
+    {
+        taskENTER_CRITICAL();
+        const Statistics copy = stats;
+        taskEXIT_CRITICAL();
+        return copy;
+    }
+
+private:
+    const CAN_ID::Message_t messageID;
+    void (*const pack)(Message*, uint8_t*);
+    Signal signals[SignalCount];
+    const uint32_t minInterval;
+    const uint32_t maxInterval;
+
+    int64_t lastSent[SignalCount]{};
+    uint32_t lastSentTime = 0;
+    bool sentOnce = false;
+    volatile bool forceRefresh = false;
+    Statistics stats{};
+};
+
+} // namespace SBT::System::Comm
+
+#endif // SBT_SYSTEM_COMM_CAN_TRANSMITPOLICY_HPP
@@ -5,6 +5,9 @@
 #include "CommCAN.hpp"
 #include "CAN.hpp"
 
+#include "FreeRTOS.h"
+#include "task.h"
+
 #ifndef SBT_CAN_SENDER_DISABLE
 #include "CanSender.hpp"
 #endif
@@ -13,13 +16,20 @@
 #endif
 
 #include "Error.hpp"
+#include "Time.hpp"
+
+using SBT::System::ErrorCode;
 
-static void commCANError(const std::string& comment)
+static void commCANError(ErrorCode code, uint32_t argument = 0,
+                         uint16_t line = __builtin_LINE())
 {
-    softfault("CommCAN: " + comment);
+    softfault({SBT::System::ErrorModule::CommCAN, code, line, argument});
 }
 
-static void commCANErrorNotInit() { commCANError("Not initialized"); }
+static void commCANErrorNotInit(uint16_t line = __builtin_LINE())
+{
+    commCANError(ErrorCode::NotInitialized, 0, line);
+}
 
 namespace SBT::System::Comm {
 
@@ -27,9 +37,12 @@ using namespace SBT::System::Comm::CAN_ID;
 
 uint8_t CAN::Filter::filterBankID = 0;
 
-std::map<uint8_t, std::function<void(CAN::RxMessage)>> CAN::filters;
+std::array<CAN::FilterCallback, CAN::filterBankCount> CAN::filters;
 Source CAN::defaultSourceID = Source::DEFAULT;
 bool CAN::initialized = false;
+#ifdef SBT_CAN_SNAPSHOT
+uint8_t CAN::snapshotCounter = 0;
+#endif
 
 CAN::Filter::Filter(Group _gID) : filterType{FilterType::MASK_FILTER}
 {
@@ -37,9 +50,11 @@ CAN::Filter::Filter(Group _gID) : filterType{FilterType::MASK_FILTER}
     filterID = 0x1FFFFFFF & static_cast<uint32_t>(_gID);
 }
 
+// Param filters ignore the snapshot counter bits, so all parts of snapshots
+// pass them
 CAN::Filter::Filter(Param _pID) : filterType{FilterType::MASK_FILTER}
 {
-    maskID = (0x1FFFFFFF & 0x0FFF) << 6;
+    maskID = (0x1FFFFFFF & 0xFF) << 6;
     filterID = (0x1FFFFFFF & static_cast<uint32_t>(_pID)) << 6;
 }
 
@@ -52,7 +67,7 @@ CAN::Filter::Filter(Source _sID) : filterType{FilterType::MASK_FILTER}
 CAN::Filter::Filter(Source _sID, Param _pID)
     : filterType{FilterType::MASK_FILTER}
 {
-    maskID = ((0x1FFFFFFF & 0xFF) << 18) | ((0x1FFFFFFF & 0x0FFF) << 6);
+    maskID = ((0x1FFFFFFF & 0xFF) << 18) | ((0x1FFFFFFF & 0xFF) << 6);
     filterID = ((0x1FFFFFFF & static_cast<uint32_t>(_sID)) << 18) |
                ((0x1FFFFFFF & static_cast<uint32_t>(_pID)) << 6);
 }
@@ -80,14 +95,13 @@ void CAN::Init(Source _sID)
     initialized = true;
 }
 
-void CAN::AddFilter(const Filter& filter,
-                    const std::function<void(RxMessage)>& callback)
+void CAN::AddFilter(const Filter& filter, FilterCallback callback)
 {
     if(!initialized)
         commCANErrorNotInit();
 
-    if(Filter::filterBankID >= 14)
-        commCANError("Too many filters. (You have only 14 filter banks)");
+    if(Filter::filterBankID >= filterBankCount)
+        commCANError(ErrorCode::CapacityExceeded, Filter::filterBankID);
 
     Hardware::can.Stop();
 
@@ -99,7 +113,7 @@ void CAN::AddFilter(const Filter& filter,
         Hardware::can.AddFilter_LIST(Filter::filterBankID, filter.GetFilterID(),
                                      filter.GetMaskID());
 
-    // Add new callback to map
+    // Add new callback to array
     filters[Filter::filterBankID++] = callback;
 
     Hardware::can.Start();
@@ -128,12 +142,33 @@ void CAN::Send(Message_t mID, uint8_t (&data)[8])
 {
     Send(TxMessage(defaultSourceID, mID, data));
 }
+
+#ifdef SBT_CAN_SNAPSHOT
+void CAN::SendSnapshot(Source sID, const Message_t* mIDs, uint8_t (*data)[8],
+                       size_t count)
+{
+    // Counter 0 is left for ordinary messages. Several tasks may send
+    // snapshots, each group keeps the counter it took here.
+    taskENTER_CRITICAL();
+    snapshotCounter = snapshotCounter % (snapshotCount - 1) + 1;
+    const uint8_t counter = snapshotCounter;
+    taskEXIT_CRITICAL();
+
+    for(size_t i = 0; i < count; i++) {
+        TxMessage message(sID, mIDs[i], data[i]);
+        message.snapshot = counter;
+        message.CalculateExtID();
+        Send(message);
+    }
+}
+#endif
 #endif
 
 #ifndef SBT_CAN_RECEIVER_DISABLE
 void CAN::CopyRxMessToQueue(uint32_t fifoId)
 {
     CAN::RxMessage message{};
+    message.timestamp = Time::GetCycles();
 
     Hardware::can.GetRxMessage(fifoId, &message.extID, message.payload,
                                &message.filterBankID);
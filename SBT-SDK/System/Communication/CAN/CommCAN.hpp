@@ -5,11 +5,12 @@
 #ifndef F1XX_PROJECT_TEMPLATE_COMMCAN_HPP
 #define F1XX_PROJECT_TEMPLATE_COMMCAN_HPP
 
-#include <functional>
-#include <map>
+#include <array>
 #include <stm32f1xx_hal.h>
 
 #include "CanID_autogenerated.hpp"
+#include "CanIDCodec.hpp"
+#include "Delegate.hpp"
 
 // We need to befriend CanReceiver in CAN class
 namespace SBT::System::Tasks {
@@ -29,9 +30,9 @@ class CAN {
         uint32_t extID;
         // Raw frame data
         uint8_t payload[8];
+        // Snapshot counter, 0 for messages which are not a part of snapshot
+        uint8_t snapshot = 0;
 
-        // Calculating our subIDs basing on extended ID
-        void CalculateSBTid();
         // Calculating extended ID basing on our SubIDs
         void CalculateExtID();
 
@@ -84,10 +85,6 @@ class CAN {
          * @return payload
          */
         [[nodiscard]] uint8_t* GetPayload() { return payload; }
-
-        // CanReceiver need to call CalculateSBTid(); which we don't want to
-        // show for standard user
-        friend Tasks::CanReceiver;
     };
 
 public:
@@ -112,6 +109,8 @@ public:
     class RxMessage : public GenericMessage {
         // Filter bank id
         uint8_t filterBankID;
+        // Time::GetCycles() in the RX interrupt
+        uint64_t timestamp;
 
     public:
         RxMessage() = default;
@@ -122,6 +121,44 @@ public:
          */
         uint8_t GetFilterBankID() { return filterBankID; }
 
+        /**
+         * @brief Getter for reception time, taken when the RX interrupt
+         * copied the message from the FIFO. Compare it with
+         * Time::GetCycles(), e.g. Time::ElapsedMicroseconds(timestamp).
+         * @return Time::GetCycles() at reception
+         */
+        [[nodiscard]] uint64_t GetTimestamp() const { return timestamp; }
+
+        // Received messages carry only the raw extended ID. SubIDs are decoded
+        // from it on every call, so callbacks which use only the raw ID and
+        // payload do not pay for decoding.
+
+        /**
+         * @brief Getter for source ID, decoded from extended ID
+         * @return source ID, UNKNOWN if out of range
+         */
+        [[nodiscard]] CAN_ID::Source GetSourceID() const
+        {
+            return CAN_ID::DecodeSource(extID);
+        }
+        /**
+         * @brief Getter for message ID, decoded from extended ID.
+         * Contains ParamID, GroupID, priority
+         * @return message ID, UNKNOWN ParamID/GroupID if out of range
+         */
+        [[nodiscard]] CAN_ID::Message_t GetMessageID() const
+        {
+            return CAN_ID::DecodeMessage(extID);
+        }
+        /**
+         * @brief Getter for snapshot counter, decoded from extended ID
+         * @return snapshot counter, 0 for ordinary messages
+         */
+        [[nodiscard]] uint8_t GetSnapshot() const
+        {
+            return CAN_ID::DecodeSnapshot(extID);
+        }
+
         friend CAN;
     };
 
@@ -200,13 +237,27 @@ public:
     };
 
 private:
-    // Mapping filter bank numbers to user callbacks
-    static std::map<uint8_t, std::function<void(RxMessage)>> filters;
+    // Number of filter banks in bxCAN of STM32F1
+    static constexpr uint8_t filterBankCount = 14;
+
+public:
+    // Callback of a filter, see Hardware::BasicDelegate. It is stored in place,
+    // so registering it never allocates.
+    using FilterCallback = Hardware::BasicDelegate<void(RxMessage)>;
+
+private:
+    // User callbacks indexed by filter bank number
+    static std::array<FilterCallback, filterBankCount> filters;
 
     // default sourceID to use when someone calls Send without CAN_ID::Source as
     // parameter
     static CAN_ID::Source defaultSourceID;
     static bool initialized;
+#ifdef SBT_CAN_SNAPSHOT
+    // Counter of sent snapshots, wraps at CAN_ID::snapshotCount. Guarded by
+    // critical section
+    static uint8_t snapshotCounter;
+#endif
 
 public:
     /**
@@ -225,10 +276,10 @@ public:
      * @brief Function for registering filters
      * @param filter Filter class object
      * @param callback callback which will be called after receiving message
-     * that passes filter
+     * that passes filter. A function pointer or a lambda capturing up to three
+     * pointers is converted to FilterCallback implicitly.
      */
-    static void AddFilter(const Filter& filter,
-                          const std::function<void(RxMessage)>& callback);
+    static void AddFilter(const Filter& filter, FilterCallback callback);
 
     /**
      * @brief Function for registering filters
@@ -245,15 +296,13 @@ public:
      * message that passes filter. A pointer to the callback function called in
      * the context of the callbackObject.
      */
-    // This template envelopes the call of the member callback function in a
-    // lambda and passes it as an independent callback function.
+    // This template stores the object and the member callback function in a
+    // FilterCallback.
     template <class T>
     static void AddFilter(const Filter& filter, T* callbackObject,
                           void (T::*callbackFunction)(RxMessage))
     {
-        AddFilter(filter, [callbackObject, callbackFunction](RxMessage mess) {
-            (callbackObject->*callbackFunction)(mess);
-        });
+        AddFilter(filter, FilterCallback(callbackObject, callbackFunction));
     }
 
     /**
@@ -288,6 +337,31 @@ public:
      * @param data Raw payload of transmitting message
      */
     static void Send(CAN_ID::Message_t mID, uint8_t (&data)[8]);
+#ifdef SBT_CAN_SNAPSHOT
+    /**
+     * @brief Add all frames of a multi-frame snapshot to transmit messages
+     * queue. All frames get the same snapshot counter in extended ID, so
+     * receivers can assemble them with SnapshotAssembler (CanSnapshot.hpp).
+     * @param sID Source ID of transmitting messages
+     * @param mIDs Message IDs of snapshot parts
+     * @param data Raw payloads of snapshot parts, in the same order as mIDs
+     * @param count number of parts
+     */
+    static void SendSnapshot(CAN_ID::Source sID, const CAN_ID::Message_t* mIDs,
+                             uint8_t (*data)[8], size_t count);
+    /**
+     * @brief Add all frames of a multi-frame snapshot to transmit messages
+     * queue. defaultSourceID is used as SourceID
+     * @param mIDs Message IDs of snapshot parts
+     * @param data Raw payloads of snapshot parts, in the same order as mIDs
+     */
+    template <size_t N>
+    static void SendSnapshot(const CAN_ID::Message_t (&mIDs)[N],
+                             uint8_t (&data)[N][8])
+    {
+        SendSnapshot(defaultSourceID, mIDs, data, N);
+    }
+#endif
 
 private:
     friend SBT::System::Tasks::CanReceiver;
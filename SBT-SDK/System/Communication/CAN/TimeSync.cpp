@@ -0,0 +1,228 @@
+#include "TimeSync.hpp"
+
+#include "CAN.hpp"
+#include "CanParser_autogenerated.hpp"
+#include "CommCAN.hpp"
+#include "Time.hpp"
+
+#ifdef SBT_TIME_SYNC_MASTER
+#ifdef SBT_CAN_SENDER_DISABLE
+#error "SBT_TIME_SYNC_MASTER sends sync frames, it requires CanSender"
+#endif
+#include "CanSender.hpp"
+#else
+#ifdef SBT_CAN_RECEIVER_DISABLE
+#error "SBT_TIME_SYNC receives sync frames, it requires CanReceiver"
+#endif
+#endif
+
+namespace SBT::System::Comm {
+
+namespace {
+constexpr int64_t ppb = 1'000'000'000;
+// Drift estimates out of this range are clipped, crystals are within 100 ppm
+constexpr int64_t maxDrift = 300'000;
+// Weight of a new drift measurement in the estimate is 1/driftFilter
+constexpr int64_t driftFilter = 4;
+
+// Clock model, guarded by masked interrupts. Synchronised time at local time
+// t (microseconds) is
+//     referenceTime + e + e * drift / ppb + slew * min(e, slewPeriod) /
+//     slewPeriod, where e = t - referenceLocal
+// so the offset error of the last sync is slewed out during slewPeriod.
+TimeSync::State state = TimeSync::State::Unsynchronised;
+uint64_t referenceLocal = 0;
+uint64_t referenceTime = 0;
+int32_t drift = 0;
+int32_t slew = 0;
+int64_t slewPeriod = 1;
+
+// Written only by the CanReceiver task, statistics under masked interrupts
+CAN_ID::Source master = CAN_ID::Source::UNKNOWN;
+int32_t offsetError = 0;
+uint32_t syncs = 0;
+uint64_t lastLocal = 0;
+uint64_t lastMaster = 0;
+bool syncReceived = false;
+uint8_t syncSequence = 0;
+CAN_ID::Source syncSource = CAN_ID::Source::UNKNOWN;
+uint64_t syncCycles = 0;
+
+#ifdef SBT_TIME_SYNC_MASTER
+uint8_t sequence = 0;
+#endif
+
+// Has to be called with interrupts masked
+uint64_t synchronised(uint64_t local)
+{
+    const auto elapsed = static_cast<int64_t>(local - referenceLocal);
+    const int64_t correction =
+        elapsed * drift / ppb +
+        (elapsed < slewPeriod ? slew * elapsed / slewPeriod : slew);
+    return referenceTime + static_cast<uint64_t>(elapsed + correction);
+}
+
+int64_t clip(int64_t value, int64_t limit)
+{
+    return value > limit ? limit : value < -limit ? -limit : value;
+}
+
+void followUpReceived(CAN_ID::Source source, uint8_t followUpSequence,
+                      uint64_t masterTime)
+{
+    // Follow-up of a sync which was lost, or of another node's sync, e.g.
+    // while a second master is misconfigured
+    if(!syncReceived || followUpSequence != syncSequence ||
+       source != syncSource)
+        return;
+    syncReceived = false;
+
+    const uint64_t local = Time::ToMicroseconds(syncCycles);
+    const auto period = static_cast<int64_t>(local - lastLocal);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const int64_t error =
+        static_cast<int64_t>(masterTime - synchronised(local));
+    __set_PRIMASK(primask);
+
+    // Only this task writes the model, so it is computed unguarded
+    uint64_t newReferenceTime = masterTime;
+    int32_t newDrift = drift;
+    int32_t newSlew = 0;
+    int32_t newOffsetError = 0;
+    if(state != TimeSync::State::Synchronised) {
+        newDrift = 0;
+    }
+    else if(error > SBT_TIME_SYNC_STEP_US || error < -SBT_TIME_SYNC_STEP_US) {
+        // Master restarted or syncs were lost for long, set the clock
+        newOffsetError = static_cast<int32_t>(clip(error, INT32_MAX));
+    }
+    else {
+        if(period > 0) {
+            const int64_t measured =
+                (static_cast<int64_t>(masterTime - lastMaster) - period) *
+                ppb / period;
+            newDrift = static_cast<int32_t>(
+                drift + (clip(measured, maxDrift) - drift) / driftFilter);
+        }
+        newReferenceTime = masterTime - static_cast<uint64_t>(error);
+        newSlew = static_cast<int32_t>(error);
+        newOffsetError = static_cast<int32_t>(error);
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    referenceLocal = local;
+    referenceTime = newReferenceTime;
+    drift = newDrift;
+    slew = newSlew;
+    slewPeriod = period > 0 ? period : 1;
+    state = TimeSync::State::Synchronised;
+    master = source;
+    offsetError = newOffsetError;
+    syncs++;
+    __set_PRIMASK(primask);
+
+    lastLocal = local;
+    lastMaster = masterTime;
+}
+
+void messageReceived(CAN::RxMessage message)
+{
+    switch(message.GetMessageID().paramID) {
+    case CAN_ID::Param::TIME_SYNC:
+        syncSequence = Unpack_TIME_SYNC(message.GetPayload()).sequence;
+        syncSource = message.GetSourceID();
+        syncCycles = message.GetTimestamp();
+        syncReceived = true;
+        break;
+    case CAN_ID::Param::TIME_SYNC_FOLLOW_UP: {
+        const TIME_SYNC_FOLLOW_UP_t followUp =
+            Unpack_TIME_SYNC_FOLLOW_UP(message.GetPayload());
+        followUpReceived(message.GetSourceID(), followUp.sequence,
+                         static_cast<uint64_t>(followUp.seconds) * 1'000'000 +
+                             followUp.microseconds);
+        break;
+    }
+    default:
+        break;
+    }
+}
+} // namespace
+
+void TimeSync::Initialize()
+{
+#ifdef SBT_TIME_SYNC_MASTER
+    state = State::Master;
+#else
+    // TIME_SYNC and TIME_SYNC_FOLLOW_UP differ only in the lowest bit of
+    // ParamID
+    constexpr auto param = static_cast<uint32_t>(CAN_ID::Param::TIME_SYNC);
+    CAN::AddFilter(CAN::Filter(param << 6, 0xFE << 6,
+                               CAN::Filter::FilterType::MASK_FILTER),
+                   messageReceived);
+#endif
+}
+
+uint64_t TimeSync::GetTime() { return ToSynchronised(Time::GetCycles()); }
+
+uint64_t TimeSync::ToSynchronised(uint64_t cycles)
+{
+    const uint64_t local = Time::ToMicroseconds(cycles);
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint64_t time =
+        state == State::Synchronised ? synchronised(local) : local;
+    __set_PRIMASK(primask);
+
+    return time;
+}
+
+TimeSync::Status TimeSync::GetStatus()
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const Status status{state, master, drift, offsetError, syncs};
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+#ifdef SBT_TIME_SYNC_MASTER
+void TimeSync::SendSync()
+{
+    uint8_t payload[8];
+    TIME_SYNC_t sync;
+    sync.sequence = sequence++;
+    Pack_TIME_SYNC(&sync, payload);
+
+    CAN::Send(CAN_ID::Message::TIME_SYNC, payload);
+}
+
+void TimeSync::TxComplete(uint32_t mailbox)
+{
+    // First, as close to the end of the frame as possible
+    const uint64_t cycles = Time::GetCycles();
+
+    uint32_t extID;
+    uint8_t payload[8];
+    Hardware::can.GetTxMailboxMessage(mailbox, &extID, payload);
+    if(CAN_ID::DecodeParam(extID) != CAN_ID::Param::TIME_SYNC)
+        return;
+
+    const uint64_t time = Time::ToMicroseconds(cycles);
+    TIME_SYNC_FOLLOW_UP_t followUp;
+    followUp.sequence = Unpack_TIME_SYNC(payload).sequence;
+    followUp.microseconds = static_cast<uint32_t>(time % 1'000'000);
+    followUp.seconds = static_cast<uint32_t>(time / 1'000'000);
+    Pack_TIME_SYNC_FOLLOW_UP(&followUp, payload);
+
+    Tasks::CanSender::AddToQueueFromISR(
+        CAN::TxMessage(CAN::GetDefaultSourceID(),
+                       CAN_ID::Message::TIME_SYNC_FOLLOW_UP, payload));
+}
+#endif
+
+} // namespace SBT::System::Comm
@@ -0,0 +1,100 @@
+#ifndef SBT_SYSTEM_COMM_TIMESYNC_HPP
+#define SBT_SYSTEM_COMM_TIMESYNC_HPP
+
+#include "CanID_autogenerated.hpp"
+
+#include <cstdint>
+
+// Offset error in microseconds above which the clock is set instead of slewed
+#ifndef SBT_TIME_SYNC_STEP_US
+#define SBT_TIME_SYNC_STEP_US 1000
+#endif
+
+namespace SBT::System::Comm {
+/**
+ * @brief Clock synchronised over CAN, enabled by SBT_TIME_SYNC. Synchronised
+ * time is the uptime of the master in microseconds, so samples of different
+ * nodes can be aligned. Local time (Time::GetUpTime(), Time::GetCycles())
+ * is not changed.
+ *
+ * The node built with SBT_TIME_SYNC_MASTER (e.g. GPS_CONTROLLER or PiBox)
+ * sends TIME_SYNC every Heartbeat period. Its TX complete interrupt takes
+ * the time the frame left the bus and sends it in TIME_SYNC_FOLLOW_UP. Other
+ * nodes take the time the same frame arrived in their RX interrupt
+ * (RxMessage::GetTimestamp()). Both are taken at the end of the frame, so
+ * queueing and arbitration delays do not matter; what is left is interrupt
+ * latency, a few microseconds. A follow-up is used only if it comes from the
+ * node which sent the last TIME_SYNC and carries its sequence.
+ *
+ * The master needs CanSender, other nodes need CanReceiver; building without
+ * them is an error.
+ *
+ * Each follow-up gives a pair of master and local time. From consecutive
+ * pairs the node estimates the drift of its crystal, low-pass filtered, and
+ * the offset error of its clock. The error is slewed out during the next
+ * period by running the clock slightly faster or slower, so the clock never
+ * steps back. Only the first pair and errors above SBT_TIME_SYNC_STEP_US
+ * (e.g. after the master restarted) set the clock directly.
+ *
+ * Heartbeat reports Status of every node as TIME_SYNC_STATUS.
+ */
+class TimeSync {
+public:
+    enum class State : uint8_t {
+        // No follow-up received yet, synchronised time is local time
+        Unsynchronised,
+        Synchronised,
+        Master
+    };
+
+    struct Status {
+        State state;
+        // Source of the last follow-up
+        CAN_ID::Source master;
+        // Estimated drift of the local clock against the master, in parts
+        // per billion, positive if the local clock is slow
+        int32_t drift;
+        // Master minus local synchronised time at the last sync, before
+        // correction, in microseconds
+        int32_t offsetError;
+        // Follow-ups used since reset
+        uint32_t syncs;
+    };
+
+    TimeSync() = delete;
+
+    /**
+     * @brief Register the CAN filter of sync frames, done by System::Start()
+     * on nodes which are not the master. Takes one filter bank.
+     */
+    static void Initialize();
+
+    // Synchronised time in microseconds
+    [[nodiscard]] static uint64_t GetTime();
+
+    /**
+     * @brief Convert a local timestamp, e.g. RxMessage::GetTimestamp(), to
+     * synchronised time in microseconds
+     * @param cycles value of Time::GetCycles()
+     */
+    [[nodiscard]] static uint64_t ToSynchronised(uint64_t cycles);
+
+    [[nodiscard]] static Status GetStatus();
+
+#ifdef SBT_TIME_SYNC_MASTER
+    /**
+     * @brief Send TIME_SYNC, its follow-up is sent when it is transmitted.
+     * Called every period by Heartbeat.
+     */
+    static void SendSync();
+
+    /**
+     * @brief Send the follow-up if mailbox transmitted TIME_SYNC, called by
+     * TX complete interrupts
+     */
+    static void TxComplete(uint32_t mailbox);
+#endif
+};
+} // namespace SBT::System::Comm
+
+#endif // SBT_SYSTEM_COMM_TIMESYNC_HPP
@@ -0,0 +1,78 @@
+#include "Coroutine.hpp"
+#include "Error.hpp"
+
+namespace SBT::System {
+
+void Event::signal()
+{
+    _set.store(true);
+    if(_waiter != nullptr)
+        xTaskNotifyGive(_waiter);
+}
+
+void Event::signalFromISR()
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    _set.store(true);
+    if(_waiter != nullptr)
+        vTaskNotifyGiveFromISR(_waiter, &xHigherPriorityTaskWoken);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+CoroutineTask::CoroutineTask(const char* name, size_t priority,
+                             size_t stackDepth)
+    : Task(name, priority, stackDepth)
+{
+}
+
+void CoroutineTask::addCoroutine(Coroutine& coroutine, size_t frameSize)
+{
+    if(_started)
+        // Coroutines have to be added before start
+        softfault({ErrorModule::Coroutine, ErrorCode::InvalidState, __LINE__,
+                   0});
+    if(_count >= _coroutines.size())
+        // Increase SBT_MAX_COROUTINES
+        softfault({ErrorModule::Coroutine, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_COROUTINES});
+
+    _coroutines[_count] = &coroutine;
+    _frameSizes[_count] = static_cast<uint16_t>(frameSize);
+    _count++;
+}
+
+void CoroutineTask::initialize() { _started = true; }
+
+void CoroutineTask::run()
+{
+    for(size_t i = 0; i < _count; i++) {
+        if(!_done[i] && _coroutines[i]->resume() == Coroutine::Status::Done)
+            _done[i] = true;
+    }
+
+    // Sleep until an event is signalled or the nearest delay expires. A
+    // coroutine is due only if the tick advanced during the resumes above,
+    // SBT_CO_YIELD waits for the next tick too.
+    TickType_t timeout = portMAX_DELAY;
+    const TickType_t now = xTaskGetTickCount();
+    for(size_t i = 0; i < _count; i++) {
+        const Coroutine* const coroutine = _coroutines[i];
+        if(_done[i] || !coroutine->_timed)
+            continue;
+
+        const int32_t wait = static_cast<int32_t>(coroutine->_wakeTick - now);
+        if(wait <= 0) {
+            timeout = 0;
+            break;
+        }
+        if(static_cast<TickType_t>(wait) < timeout)
+            timeout = static_cast<TickType_t>(wait);
+    }
+
+    if(timeout != 0)
+        ulTaskNotifyTake(pdTRUE, timeout);
+}
+
+} // namespace SBT::System
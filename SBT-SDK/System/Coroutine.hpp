@@ -0,0 +1,245 @@
+#ifndef SBT_SYSTEM_COROUTINE_HPP
+#define SBT_SYSTEM_COROUTINE_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Task.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Maximal number of coroutines in one CoroutineTask
+#ifndef SBT_MAX_COROUTINES
+#define SBT_MAX_COROUTINES 16
+#endif
+
+/**
+ * @brief Stackless coroutines for I/O-bound logic, e.g. sensor drivers waiting
+ * for transfer complete callbacks. Many coroutines run on one CoroutineTask
+ * and share its stack. State of a coroutine is its object, so its RAM use is
+ * sizeof(object) instead of a whole task stack.
+ *
+ * resume() is written as a sequential function between SBT_CO_BEGIN and
+ * SBT_CO_END. SBT_CO_AWAIT, SBT_CO_AWAIT_FOR, SBT_CO_DELAY and SBT_CO_YIELD
+ * suspend it; the next resume() continues after the suspending statement.
+ * Local variables do not survive suspension - keep state in members. Only one
+ * SBT_CO_* statement per line.
+ *
+ * Example:
+ * struct Sensor : Coroutine {
+ *     Event rxDone;
+ *     uint8_t data[2];
+ *
+ *     Sensor() { rxDone.bind(i2c, I2C::CallbackType::MasterRxComplete); }
+ *
+ *     Status resume() override
+ *     {
+ *         SBT_CO_BEGIN;
+ *         while(true) {
+ *             rxDone.reset();
+ *             i2c.ReceiveMasterIT(address, data, 2);
+ *             SBT_CO_AWAIT(rxDone);
+ *             ...
+ *             SBT_CO_DELAY(100);
+ *         }
+ *         SBT_CO_END;
+ *     }
+ * };
+ * static Sensor sensor;
+ * ...
+ * coroutineTask.addCoroutine(sensor);
+ */
+
+namespace SBT::System {
+
+// Completion flag set from a callback, awaited by a coroutine
+class Event {
+public:
+    // Set from task context
+    void signal();
+    // Set from interrupt, e.g. a HAL completion callback
+    void signalFromISR();
+
+    // Clear a stale completion, call before starting the awaited operation
+    void reset() { _set.store(false); }
+
+    /**
+     * @brief Signal this event from a driver callback
+     * @param driver UART, SPI_t, I2C or hCAN object
+     * @param callbackType driver's CallbackType, e.g. TxComplete
+     */
+    template <typename Driver, typename CallbackType>
+    void bind(Driver& driver, CallbackType callbackType)
+    {
+        driver.RegisterCallback(callbackType, this, &Event::signalFromISR);
+    }
+
+    // Used by SBT_CO_AWAIT
+    void arm() { _waiter = xTaskGetCurrentTaskHandle(); }
+    bool take() { return _set.exchange(false); }
+
+private:
+    std::atomic<bool> _set{false};
+    TaskHandle_t _waiter = nullptr;
+};
+
+// Latest value posted from task context, e.g. a CAN message from CanReceiver:
+// CAN::AddFilter(filter, &mailbox, &Mailbox<CAN::RxMessage>::post);
+template <typename T> class Mailbox {
+public:
+    void post(T value)
+    {
+        taskENTER_CRITICAL();
+        _value = value;
+        taskEXIT_CRITICAL();
+        _event.signal();
+    }
+
+    // Copy of the last posted value
+    [[nodiscard]] T get() const
+    {
+        taskENTER_CRITICAL();
+        const T copy = _value;
+        taskEXIT_CRITICAL();
+        return copy;
+    }
+
+    void reset() { _event.reset(); }
+
+    // Used by SBT_CO_AWAIT
+    void arm() { _event.arm(); }
+    bool take() { return _event.take(); }
+
+private:
+    T _value{};
+    Event _event;
+};
+
+class Coroutine {
+public:
+    enum class Status {
+        // Suspended, resume() has to be called again
+        Waiting,
+        // Reached SBT_CO_END, will not be resumed anymore
+        Done
+    };
+
+    virtual ~Coroutine() = default;
+
+    // Run until the next suspension point, see SBT_CO_BEGIN
+    virtual Status resume() = 0;
+
+protected:
+    // Line of the suspension point to continue from, 0 before the first run
+    uint32_t _resumePoint = 0;
+    // Tick at which SBT_CO_DELAY or SBT_CO_AWAIT_FOR ends, if _timed
+    TickType_t _wakeTick = 0;
+    bool _timed = false;
+
+    friend class CoroutineTask;
+};
+
+// Task which runs coroutines. On every wake-up (event signalled or delay
+// expired) it resumes all unfinished coroutines, then blocks on its task
+// notification until the nearest delay.
+class CoroutineTask : public Task {
+public:
+    CoroutineTask(const char* name, size_t priority, size_t stackDepth);
+
+    // Coroutines have to be added before the task starts
+    template <typename T> void addCoroutine(T& coroutine)
+    {
+        addCoroutine(coroutine, sizeof(T));
+    }
+
+    [[nodiscard]] size_t getCoroutineCount() const { return _count; }
+    // RAM used by state of a coroutine, in bytes
+    [[nodiscard]] size_t getFrameSize(size_t index) const
+    {
+        return _frameSizes[index];
+    }
+
+    void initialize() override;
+    void run() override;
+
+private:
+    void addCoroutine(Coroutine& coroutine, size_t frameSize);
+
+    std::array<Coroutine*, SBT_MAX_COROUTINES> _coroutines{};
+    std::array<uint16_t, SBT_MAX_COROUTINES> _frameSizes{};
+    std::array<bool, SBT_MAX_COROUTINES> _done{};
+    size_t _count = 0;
+    bool _started = false;
+};
+
+} // namespace SBT::System
+
+// Start of coroutine body in resume()
+#define SBT_CO_BEGIN                                                           \
+    switch(_resumePoint) {                                                     \
+    case 0:
+
+// End of coroutine body in resume()
+#define SBT_CO_END                                                             \
+    }                                                                          \
+    _timed = false;                                                            \
+    return Status::Done
+
+// Let other coroutines and lower priority tasks run, continue on the next
+// wake-up of the task, at the latest on the next tick. The task blocks at
+// least until then, so a yielding loop does not starve Idle.
+#define SBT_CO_YIELD()                                                         \
+    do {                                                                       \
+        _wakeTick = xTaskGetTickCount() + 1;                                   \
+        _timed = true;                                                         \
+        _resumePoint = __LINE__;                                               \
+        return Status::Waiting;                                                \
+    case __LINE__:                                                             \
+        _timed = false;                                                        \
+    } while(0)
+
+// Wait until EVENT (Event or Mailbox) is signalled
+#define SBT_CO_AWAIT(EVENT)                                                    \
+    do {                                                                       \
+        (EVENT).arm();                                                         \
+        _resumePoint = __LINE__;                                               \
+        [[fallthrough]];                                                       \
+    case __LINE__:                                                             \
+        if(!(EVENT).take())                                                    \
+            return Status::Waiting;                                            \
+    } while(0)
+
+// Wait until EVENT is signalled or TIMEOUT ms pass, OK is set to false on
+// timeout
+#define SBT_CO_AWAIT_FOR(EVENT, TIMEOUT, OK)                                   \
+    do {                                                                       \
+        (EVENT).arm();                                                         \
+        _wakeTick = xTaskGetTickCount() + (TIMEOUT);                           \
+        _timed = true;                                                         \
+        _resumePoint = __LINE__;                                               \
+        [[fallthrough]];                                                       \
+    case __LINE__:                                                             \
+        (OK) = (EVENT).take();                                                 \
+        if(!(OK) &&                                                            \
+           static_cast<int32_t>(xTaskGetTickCount() - _wakeTick) < 0)          \
+            return Status::Waiting;                                            \
+        _timed = false;                                                        \
+    } while(0)
+
+// Wait for MS milliseconds
+#define SBT_CO_DELAY(MS)                                                       \
+    do {                                                                       \
+        _wakeTick = xTaskGetTickCount() + (MS);                                \
+        _timed = true;                                                         \
+        _resumePoint = __LINE__;                                               \
+        [[fallthrough]];                                                       \
+    case __LINE__:                                                             \
+        if(static_cast<int32_t>(xTaskGetTickCount() - _wakeTick) < 0)          \
+            return Status::Waiting;                                            \
+        _timed = false;                                                        \
+    } while(0)
+
+#endif // SBT_SYSTEM_COROUTINE_HPP
@@ -0,0 +1,90 @@
+#include "Counters.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Error.hpp"
+#include "UART.hpp"
+
+#include <cstdio>
+
+namespace SBT::System {
+
+namespace {
+// Zero-initialised before any constructor runs, so counters defined in any
+// file can register
+Counter* counters[SBT_MAX_COUNTERS];
+size_t counterCount;
+} // namespace
+
+Counter::Counter(const char* name, Kind kind) : _name(name), _kind(kind)
+{
+    Counters::Register(*this);
+}
+
+uint16_t Counter::GetId() const
+{
+    uint32_t hash = 2166136261U;
+    for(const char* c = _name; *c != '\0'; c++) {
+        hash ^= static_cast<uint8_t>(*c);
+        hash *= 16777619U;
+    }
+    return static_cast<uint16_t>((hash >> 16) ^ hash);
+}
+
+void Counters::Register(Counter& counter)
+{
+    // Too many counters, raise SBT_MAX_COUNTERS
+    if(counterCount == SBT_MAX_COUNTERS)
+        softfault({ErrorModule::Counters, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_COUNTERS});
+
+    // Only static constructors register, before the scheduler starts
+    counters[counterCount] = &counter;
+    counterCount++;
+}
+
+size_t Counters::GetCount() { return counterCount; }
+
+const Counter* Counters::Get(size_t index)
+{
+    return index < counterCount ? counters[index] : nullptr;
+}
+
+size_t Counters::Snapshot(uint32_t* values, size_t count)
+{
+    taskENTER_CRITICAL();
+    const size_t copied = count < counterCount ? count : counterCount;
+    for(size_t i = 0; i < copied; i++)
+        values[i] = counters[i]->Get();
+    taskEXIT_CRITICAL();
+    return copied;
+}
+
+void Counters::Report(Hardware::UART& uart)
+{
+    // Buffers have to stay untouched until the previous transmission completes
+    static char line[96];
+    static uint32_t values[SBT_MAX_COUNTERS];
+
+    const size_t count = Snapshot(values, SBT_MAX_COUNTERS);
+    for(size_t i = 0; i < count; i++) {
+        while(!uart.IsTxComplete()) {
+        }
+        const int length = snprintf(
+            line, sizeof(line),
+            "{\"counter\":\"%s\",\"kind\":\"%s\",\"value\":%lu}\n",
+            counters[i]->GetName(),
+            counters[i]->GetKind() == Counter::Kind::Gauge ? "gauge"
+                                                           : "counter",
+            static_cast<unsigned long>(values[i]));
+        if(length > 0 && static_cast<size_t>(length) < sizeof(line))
+            uart.Send(reinterpret_cast<uint8_t*>(line),
+                      static_cast<size_t>(length));
+    }
+
+    while(!uart.IsTxComplete()) {
+    }
+}
+
+} // namespace SBT::System
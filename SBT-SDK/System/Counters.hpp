@@ -0,0 +1,141 @@
+#ifndef SBT_SYSTEM_COUNTERS_HPP
+#define SBT_SYSTEM_COUNTERS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Maximal number of counters registered in Counters
+#ifndef SBT_MAX_COUNTERS
+#define SBT_MAX_COUNTERS 48
+#endif
+
+// Number of COUNTER messages sent by Heartbeat per period
+#ifndef SBT_COUNTER_FRAMES
+#define SBT_COUNTER_FRAMES 4
+#endif
+
+namespace SBT::Hardware {
+class UART;
+}
+
+namespace SBT::System {
+/**
+ * @brief Named 32-bit counter or gauge, registered in Counters when it is
+ * constructed. Counters are meant to be static objects, e.g.
+ *     Counter rxFrames{"can.rxFrames"};
+ * constructed before main(), so registration does not need a lock. They are
+ * never unregistered.
+ *
+ * Increment(), Add() and Set() are safe in tasks and interrupts: relaxed
+ * atomic operations, a load and store exclusive loop of a few instructions,
+ * without a critical section. Counters wrap at 2^32, compare two readings by
+ * unsigned subtraction.
+ *
+ * Without SBT_COUNTERS all operations are empty and compile out, so drivers
+ * count unconditionally.
+ */
+class Counter {
+public:
+    enum class Kind : uint8_t {
+        // Number of events since reset, only grows
+        Counter,
+        // Current level, e.g. queue fill
+        Gauge
+    };
+
+#ifdef SBT_COUNTERS
+    // Not explicit, so arrays of counters can be initialised with names
+    Counter(const char* name, Kind kind = Kind::Counter);
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void Increment() { _value.fetch_add(1, std::memory_order_relaxed); }
+
+    void Add(uint32_t amount)
+    {
+        _value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void Set(uint32_t value) { _value.store(value, std::memory_order_relaxed); }
+
+    [[nodiscard]] uint32_t Get() const
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const char* GetName() const { return _name; }
+
+    [[nodiscard]] Kind GetKind() const { return _kind; }
+
+    /**
+     * @brief 16-bit FNV-1a hash of the name, identifies the counter in
+     * COUNTER messages independently of the registration order
+     */
+    [[nodiscard]] uint16_t GetId() const;
+
+private:
+    const char* _name;
+    std::atomic<uint32_t> _value{0};
+    Kind _kind;
+#else
+    constexpr Counter(const char*, Kind = Kind::Counter) {}
+
+    void Increment() {}
+    void Add(uint32_t) {}
+    void Set(uint32_t) {}
+    [[nodiscard]] uint32_t Get() const { return 0; }
+#endif
+};
+
+// Counter of Kind::Gauge
+class Gauge : public Counter {
+public:
+    Gauge(const char* name) : Counter(name, Kind::Gauge) {}
+};
+
+#ifdef SBT_COUNTERS
+/**
+ * @brief Registry of all counters, enabled by SBT_COUNTERS. Counters are kept
+ * in registration order; within one file it is the order of definition.
+ *
+ * Snapshot() copies all values at one instant, in a critical section, so
+ * related counters (e.g. frames and errors) are consistent with each other.
+ * With the CAN sender, Heartbeat streams snapshots as COUNTER messages,
+ * SBT_COUNTER_FRAMES counters per period.
+ */
+class Counters {
+public:
+    Counters() = delete;
+
+    /**
+     * @brief Add a counter, called by its constructor. Softfaults when more
+     * than SBT_MAX_COUNTERS are registered.
+     */
+    static void Register(Counter& counter);
+
+    [[nodiscard]] static size_t GetCount();
+
+    // Counter at index in registration order, nullptr if out of range
+    [[nodiscard]] static const Counter* Get(size_t index);
+
+    /**
+     * @brief Copy values of all counters at one instant
+     * @param values destination, in registration order
+     * @param count size of values
+     * @return number of values written
+     */
+    static size_t Snapshot(uint32_t* values, size_t count);
+
+    /**
+     * @brief Send a snapshot as JSON lines, one per counter:
+     * {"counter":"uart1.txBytes","kind":"counter","value":1234}
+     * Blocks until transmission completes.
+     */
+    static void Report(Hardware::UART& uart);
+};
+#endif
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_COUNTERS_HPP
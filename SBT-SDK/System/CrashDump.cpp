@@ -0,0 +1,131 @@
+#include "CrashDump.hpp"
+
+#include "task.h"
+
+#include "Error.hpp"
+#include "NoInit.hpp"
+
+#include <cstring>
+#include <stm32f1xx_hal.h>
+
+// Top of the main stack, end of RAM used by the firmware
+extern "C" uint32_t _estack;
+
+namespace SBT::System {
+
+namespace {
+constexpr uint32_t recordMagic = 0xC4A5D0C0;
+
+// Words of the exception frame stacked by the processor
+constexpr size_t frameWords = 8;
+
+struct Stored {
+    uint32_t magic;
+    CrashDump::Record record;
+};
+SBT_NOINIT Stored stored;
+
+bool hasLastCrash = false;
+
+bool isInRam(uintptr_t address, size_t words)
+{
+    const auto end = reinterpret_cast<uintptr_t>(&_estack);
+    return address >= SRAM_BASE && address % sizeof(uint32_t) == 0 &&
+           address <= end && (end - address) / sizeof(uint32_t) >= words;
+}
+} // namespace
+
+void CrashDump::Initialize()
+{
+    // The record stays in .noinit until the next fault overwrites it
+    hasLastCrash = stored.magic == recordMagic;
+    stored.magic = 0;
+
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk |
+                  SCB_SHCSR_USGFAULTENA_Msk;
+}
+
+const CrashDump::Record* CrashDump::GetLastCrash()
+{
+    return hasLastCrash ? &stored.record : nullptr;
+}
+
+uint32_t CrashDump::GetLastCrashWord(size_t index)
+{
+    uint32_t word = 0;
+    if(hasLastCrash && index < RecordWords)
+        memcpy(&word,
+               reinterpret_cast<const uint8_t*>(&stored.record) +
+                   index * sizeof(uint32_t),
+               sizeof(word));
+    return word;
+}
+
+} // namespace SBT::System
+
+using SBT::System::CrashDump;
+
+// Called by the fault handlers with the address of the exception frame and
+// EXC_RETURN. Reads the faulting stack only where it lies in RAM, so a
+// corrupted stack pointer does not fault again.
+extern "C" [[noreturn]] __attribute__((used)) void
+CrashDumpCapture(const uint32_t* frame, uint32_t excReturn)
+{
+    using namespace SBT::System;
+    CrashDump::Record& record = stored.record;
+    memset(&record, 0, sizeof(record));
+
+    const auto sp = reinterpret_cast<uintptr_t>(frame);
+    if(isInRam(sp, frameWords)) {
+        record.r0 = frame[0];
+        record.r1 = frame[1];
+        record.r2 = frame[2];
+        record.r3 = frame[3];
+        record.r12 = frame[4];
+        record.lr = frame[5];
+        record.pc = frame[6];
+        record.xpsr = frame[7];
+
+        const uint32_t* stack = frame + frameWords;
+        for(size_t i = 0; i < SBT_CRASH_STACK_WORDS; i++) {
+            if(!isInRam(reinterpret_cast<uintptr_t>(stack + i), 1))
+                break;
+            record.stack[i] = stack[i];
+            record.stackWords++;
+        }
+    }
+
+    record.cfsr = SCB->CFSR;
+    record.hfsr = SCB->HFSR;
+    record.mmfar = SCB->MMFAR;
+    record.bfar = SCB->BFAR;
+    record.excReturn = excReturn;
+    record.sp = sp;
+
+    if(xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+        strncpy(record.taskName, pcTaskGetName(nullptr),
+                sizeof(record.taskName) - 1);
+
+    stored.magic = recordMagic;
+
+    softfault({ErrorModule::System, ErrorCode::Fault, 0, record.pc});
+}
+
+// Pass the stack pointer which was active when the fault occurred - PSP for
+// tasks, MSP for interrupts and code before the scheduler starts
+extern "C" __attribute__((naked)) void HardFault_Handler()
+{
+    __asm volatile("tst lr, #4             \n"
+                   "ite eq                 \n"
+                   "mrseq r0, msp          \n"
+                   "mrsne r0, psp          \n"
+                   "mov r1, lr             \n"
+                   "b CrashDumpCapture     \n");
+}
+
+extern "C" void MemManage_Handler()
+    __attribute__((naked, alias("HardFault_Handler")));
+extern "C" void BusFault_Handler()
+    __attribute__((naked, alias("HardFault_Handler")));
+extern "C" void UsageFault_Handler()
+    __attribute__((naked, alias("HardFault_Handler")));
@@ -0,0 +1,93 @@
+#ifndef SBT_SYSTEM_CRASHDUMP_HPP
+#define SBT_SYSTEM_CRASHDUMP_HPP
+
+#include "FreeRTOS.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Number of stack words above the exception frame kept in the record
+#ifndef SBT_CRASH_STACK_WORDS
+#define SBT_CRASH_STACK_WORDS 16
+#endif
+
+// Number of CRASH_DUMP frames sent by Heartbeat in one period
+#ifndef SBT_CRASH_DUMP_FRAMES
+#define SBT_CRASH_DUMP_FRAMES 8
+#endif
+
+namespace SBT::System {
+/**
+ * @brief Capture of processor faults, enabled by SBT_CRASH_DUMP. The SDK then
+ * defines HardFault_Handler, MemManage_Handler, BusFault_Handler and
+ * UsageFault_Handler - remove them from the application's stm32f1xx_it.c.
+ *
+ * The handler saves the exception frame, fault status and address registers,
+ * the name of the running task and a part of the faulting stack to .noinit
+ * RAM (see NoInit.hpp). Then it reports ErrorCode::Fault through softfault(),
+ * which halts or resets according to SBT_ERROR_HALT/SBT_ERROR_RESET.
+ *
+ * After reboot Heartbeat streams the record word by word as CRASH_DUMP
+ * messages: index of the word, number of words and the word. Words follow
+ * the order of Record fields, so the host can resolve pc, lr and the stack
+ * words with the firmware's ELF.
+ */
+class CrashDump {
+public:
+    struct Record {
+        // Exception frame stacked by the processor
+        uint32_t r0;
+        uint32_t r1;
+        uint32_t r2;
+        uint32_t r3;
+        uint32_t r12;
+        uint32_t lr;
+        uint32_t pc;
+        uint32_t xpsr;
+
+        uint32_t cfsr;
+        uint32_t hfsr;
+        uint32_t mmfar;
+        uint32_t bfar;
+        // LR of the handler, bit 2 set if the faulting code used PSP
+        uint32_t excReturn;
+        // Address of the exception frame
+        uint32_t sp;
+
+        // Empty if the scheduler was not started
+        char taskName[configMAX_TASK_NAME_LEN];
+
+        // Stack words following the exception frame, fewer near the stack top
+        uint32_t stackWords;
+        uint32_t stack[SBT_CRASH_STACK_WORDS];
+    };
+
+    static constexpr size_t RecordWords = sizeof(Record) / sizeof(uint32_t);
+    static_assert(RecordWords <= UINT8_MAX,
+                  "CRASH_DUMP indexes words with 8 bits, reduce "
+                  "SBT_CRASH_STACK_WORDS");
+
+    CrashDump() = delete;
+
+    /**
+     * @brief Take over the record of the previous reset and enable MemManage,
+     * BusFault and UsageFault exceptions, which would otherwise escalate to
+     * HardFault. Called by System::Init().
+     */
+    static void Initialize();
+
+    /**
+     * @brief Record of the crash which caused the last reset
+     * @return nullptr if the last reset was not caused by a fault
+     */
+    [[nodiscard]] static const Record* GetLastCrash();
+
+    /**
+     * @brief Word of the last crash record, as sent in CRASH_DUMP
+     * @param index less than RecordWords
+     */
+    [[nodiscard]] static uint32_t GetLastCrashWord(size_t index);
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_CRASHDUMP_HPP
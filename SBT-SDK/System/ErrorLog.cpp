@@ -0,0 +1,66 @@
+#include "ErrorLog.hpp"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "NoInit.hpp"
+
+namespace SBT::System {
+
+namespace {
+constexpr uint32_t ringMagic = 0xE5510C0D;
+
+struct Ring {
+    uint32_t magic;
+    // Free-running counts, entry n is at entries[n % SBT_ERROR_LOG_SIZE]
+    uint32_t written;
+    uint32_t reported;
+    Error entries[SBT_ERROR_LOG_SIZE];
+};
+SBT_NOINIT Ring ring;
+
+void validate()
+{
+    if(ring.magic == ringMagic &&
+       ring.written - ring.reported <= SBT_ERROR_LOG_SIZE)
+        return;
+
+    ring.written = 0;
+    ring.reported = 0;
+    ring.magic = ringMagic;
+}
+} // namespace
+
+void ErrorLog::Append(const Error& error)
+{
+    validate();
+
+    ring.entries[ring.written % SBT_ERROR_LOG_SIZE] = error;
+    ring.written++;
+
+    // Drop the overwritten entry
+    if(ring.written - ring.reported > SBT_ERROR_LOG_SIZE)
+        ring.reported = ring.written - SBT_ERROR_LOG_SIZE;
+}
+
+bool ErrorLog::PopUnreported(Error& error)
+{
+    taskENTER_CRITICAL();
+    validate();
+    const bool pending = ring.reported != ring.written;
+    if(pending)
+        error = ring.entries[ring.reported++ % SBT_ERROR_LOG_SIZE];
+    taskEXIT_CRITICAL();
+    return pending;
+}
+
+uint32_t ErrorLog::GetCount()
+{
+    taskENTER_CRITICAL();
+    validate();
+    const uint32_t count = ring.written;
+    taskEXIT_CRITICAL();
+    return count;
+}
+
+} // namespace SBT::System
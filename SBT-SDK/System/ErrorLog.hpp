@@ -0,0 +1,45 @@
+#ifndef SBT_SYSTEM_ERRORLOG_HPP
+#define SBT_SYSTEM_ERRORLOG_HPP
+
+#include "Error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Number of errors kept in the log, the oldest are overwritten
+#ifndef SBT_ERROR_LOG_SIZE
+#define SBT_ERROR_LOG_SIZE 8
+#endif
+
+namespace SBT::System {
+/**
+ * @brief Ring of the last errors reported by softfault() and FreeRTOS hooks.
+ * It is kept in .noinit RAM (see NoInit.hpp), so errors which ended in a halt
+ * and watchdog reset, or in SBT_ERROR_RESET, are available after reboot.
+ * Heartbeat sends errors not reported yet as ERROR_LOG messages.
+ *
+ * The ring is validated on first use after reset and cleared if it does not
+ * hold valid data, e.g. after power-on.
+ */
+class ErrorLog {
+public:
+    ErrorLog() = delete;
+
+    /**
+     * @brief Add an error to the log. Called by softfault() with interrupts
+     * disabled, does not allocate.
+     */
+    static void Append(const Error& error);
+
+    /**
+     * @brief Take the oldest error which was not reported yet
+     * @return false if all errors were reported
+     */
+    static bool PopUnreported(Error& error);
+
+    // Errors logged since the log was cleared, including overwritten ones
+    [[nodiscard]] static uint32_t GetCount();
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_ERRORLOG_HPP
@@ -0,0 +1,134 @@
+#include "Heap.hpp"
+
+#include "FreeRTOS.h"
+
+#include "Error.hpp"
+#include "UART.hpp"
+
+#include <cstdio>
+#include <new>
+
+namespace SBT::System {
+
+namespace {
+volatile bool frozen = false;
+
+void* allocate(size_t size, bool nothrow)
+{
+    // Allocation after Heap::Freeze(), requested size
+    if(frozen)
+        softfault({ErrorModule::Heap, ErrorCode::InvalidState, __LINE__,
+                   static_cast<uint32_t>(size)});
+
+    // Every new has to return a unique pointer, even for zero bytes
+    void* pointer = pvPortMalloc(size != 0 ? size : 1);
+
+    // Heap exhausted, requested size
+    if(pointer == nullptr && !nothrow)
+        softfault({ErrorModule::Heap, ErrorCode::MallocFailed, __LINE__,
+                   static_cast<uint32_t>(size)});
+
+    return pointer;
+}
+} // namespace
+
+Heap::Statistics Heap::GetStatistics()
+{
+    HeapStats_t stats{};
+    vPortGetHeapStats(&stats);
+
+    return {configTOTAL_HEAP_SIZE,
+            static_cast<uint32_t>(configTOTAL_HEAP_SIZE -
+                                  stats.xAvailableHeapSpaceInBytes),
+            static_cast<uint32_t>(configTOTAL_HEAP_SIZE -
+                                  stats.xMinimumEverFreeBytesRemaining),
+            static_cast<uint32_t>(stats.xSizeOfLargestFreeBlockInBytes),
+            static_cast<uint32_t>(stats.xNumberOfSuccessfulAllocations),
+            static_cast<uint32_t>(stats.xNumberOfSuccessfulFrees)};
+}
+
+void Heap::Freeze() { frozen = true; }
+
+bool Heap::IsFrozen() { return frozen; }
+
+void Heap::Report(Hardware::UART& uart)
+{
+    // Buffer has to stay untouched until the previous transmission completes
+    static char line[160];
+
+    const Statistics stats = GetStatistics();
+
+    while(!uart.IsTxComplete()) {
+    }
+    const int length = snprintf(
+        line, sizeof(line),
+        "{\"heap\":%lu,\"used\":%lu,\"peak\":%lu,\"largestFree\":%lu,"
+        "\"allocations\":%lu,\"frees\":%lu}\n",
+        static_cast<unsigned long>(stats.size),
+        static_cast<unsigned long>(stats.used),
+        static_cast<unsigned long>(stats.peakUsed),
+        static_cast<unsigned long>(stats.largestFreeBlock),
+        static_cast<unsigned long>(stats.allocations),
+        static_cast<unsigned long>(stats.frees));
+    if(length > 0 && static_cast<size_t>(length) < sizeof(line))
+        uart.Send(reinterpret_cast<uint8_t*>(line),
+                  static_cast<size_t>(length));
+
+    while(!uart.IsTxComplete()) {
+    }
+}
+
+} // namespace SBT::System
+
+#ifdef SBT_HEAP_FREEZE
+extern "C" {
+// Called by pvPortMalloc() for every allocation, see FreeRTOSConfig.h. Catches
+// also queues, semaphores and tasks created after the freeze.
+void vHeapAllocated(size_t size)
+{
+    using namespace SBT::System;
+    // Allocation after Heap::Freeze(), requested size
+    if(Heap::IsFrozen())
+        softfault({ErrorModule::Heap, ErrorCode::InvalidState, __LINE__,
+                   static_cast<uint32_t>(size)});
+}
+}
+#endif
+
+// Replacements of the global allocation functions. Aligned variants are left
+// to the toolchain, nothing in the SDK needs alignment above 8 bytes.
+
+void* operator new(size_t size) { return SBT::System::allocate(size, false); }
+
+void* operator new[](size_t size)
+{
+    return SBT::System::allocate(size, false);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return SBT::System::allocate(size, true);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return SBT::System::allocate(size, true);
+}
+
+void operator delete(void* pointer) noexcept { vPortFree(pointer); }
+
+void operator delete[](void* pointer) noexcept { vPortFree(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { vPortFree(pointer); }
+
+void operator delete[](void* pointer, size_t) noexcept { vPortFree(pointer); }
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    vPortFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    vPortFree(pointer);
+}
@@ -0,0 +1,61 @@
+#ifndef SBT_SYSTEM_HEAP_HPP
+#define SBT_SYSTEM_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SBT::Hardware {
+class UART;
+}
+
+namespace SBT::System {
+/**
+ * @brief Statistics of the FreeRTOS heap (heap_4, configTOTAL_HEAP_SIZE).
+ *
+ * Global operator new and delete are replaced (see Heap.cpp) to allocate from
+ * the FreeRTOS heap instead of the newlib one, so C++ objects, std::function
+ * and STL containers share one pool with tasks, queues and semaphores.
+ * pvPortMalloc() suspends the scheduler, so allocation is thread safe, but
+ * not allowed in interrupts. new softfaults when the heap is exhausted, the
+ * nothrow variants return nullptr.
+ *
+ * With SBT_HEAP_FREEZE the heap is frozen when the last registered task
+ * returns from its initialize() (see TaskManager::taskInitialized()). Any
+ * allocation after that softfaults with the requested size,
+ * to prove the running system is allocation free. Freeing is still allowed.
+ */
+class Heap {
+public:
+    // All sizes in bytes
+    struct Statistics {
+        uint32_t size;
+        uint32_t used;
+        // Highest use since reset
+        uint32_t peakUsed;
+        uint32_t largestFreeBlock;
+        // Successful allocations and frees since reset
+        uint32_t allocations;
+        uint32_t frees;
+    };
+
+    Heap() = delete;
+
+    [[nodiscard]] static Statistics GetStatistics();
+
+    /**
+     * @brief Softfault on any further allocation. Done by TaskManager with
+     * SBT_HEAP_FREEZE.
+     */
+    static void Freeze();
+
+    [[nodiscard]] static bool IsFrozen();
+
+    /**
+     * @brief Send the statistics as a JSON line. Waits until the transmission
+     * completes.
+     */
+    static void Report(Hardware::UART& uart);
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_HEAP_HPP
@@ -0,0 +1,140 @@
+#include "JobScheduler.hpp"
+#include "CycleCounter.hpp"
+#include "Error.hpp"
+
+#include <algorithm>
+
+namespace SBT::System {
+
+Job::Job(const char* name, uint8_t priority, uint32_t period, uint32_t offset)
+    : _name(name), _priority(priority), _period(period), _offset(offset)
+{
+}
+
+void Job::dispatch(TickType_t now)
+{
+    const uint32_t lateness = now - _nextRelease;
+
+    const uint32_t start = Hardware::CycleCounter::Get();
+    run();
+    const uint32_t executionCycles = Hardware::CycleCounter::Get() - start;
+
+    // Skip releases which passed while the job was waiting or running
+    _nextRelease += _period;
+    const TickType_t end = xTaskGetTickCount();
+    const bool overrun = static_cast<int32_t>(end - _nextRelease) >= 0;
+    uint32_t skipped = 0;
+    if(overrun) {
+        skipped = (end - _nextRelease) / _period + 1;
+        _nextRelease += skipped * _period;
+    }
+
+    taskENTER_CRITICAL();
+    _runs++;
+    if(overrun)
+        _overruns++;
+    _skippedReleases += skipped;
+    if(lateness > _latenessMax)
+        _latenessMax = lateness;
+    if(executionCycles > _executionMax)
+        _executionMax = executionCycles;
+    _executionSum += executionCycles;
+    taskEXIT_CRITICAL();
+}
+
+Job::Statistics Job::getStatistics() const
+{
+    taskENTER_CRITICAL();
+    const uint32_t runs = _runs;
+    const uint32_t overruns = _overruns;
+    const uint32_t skippedReleases = _skippedReleases;
+    const uint32_t latenessMax = _latenessMax;
+    const uint32_t executionMax = _executionMax;
+    const uint64_t executionSum = _executionSum;
+    taskEXIT_CRITICAL();
+
+    using Hardware::CycleCounter;
+    Statistics stats{};
+    stats.runs = runs;
+    stats.overruns = overruns;
+    stats.skippedReleases = skippedReleases;
+    stats.latenessMaxMs = latenessMax * 1000 / configTICK_RATE_HZ;
+    if(runs != 0) {
+        stats.executionMaxUs = CycleCounter::ToMicroseconds(executionMax);
+        stats.executionMeanUs =
+            CycleCounter::ToMicroseconds(executionSum / runs);
+    }
+    return stats;
+}
+
+JobScheduler::JobScheduler(const char* name, size_t priority,
+                           size_t stackDepth)
+    : Task(name, priority, stackDepth)
+{
+}
+
+void JobScheduler::addJob(Job& job)
+{
+    if(_started)
+        // Jobs have to be added before start
+        softfault({ErrorModule::JobScheduler, ErrorCode::InvalidState, __LINE__,
+                   0});
+    if(_jobCount >= _heap.size())
+        // Increase SBT_MAX_JOBS
+        softfault({ErrorModule::JobScheduler, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_JOBS});
+    if(job._period == 0)
+        softfault({ErrorModule::JobScheduler, ErrorCode::InvalidArgument,
+                   __LINE__, job._period});
+
+    _heap[_jobCount++] = &job;
+}
+
+bool JobScheduler::runsLater(const Job* a, const Job* b)
+{
+    // Wrap-safe comparison of tick counts
+    const int32_t difference =
+        static_cast<int32_t>(a->_nextRelease - b->_nextRelease);
+    if(difference != 0)
+        return difference > 0;
+    return a->_priority < b->_priority;
+}
+
+void JobScheduler::initialize()
+{
+    _started = true;
+    Hardware::CycleCounter::Enable();
+
+    const TickType_t now = xTaskGetTickCount();
+    for(size_t i = 0; i < _jobCount; i++) {
+        _heap[i]->initialize();
+        _heap[i]->_nextRelease = now + _heap[i]->_offset;
+    }
+    std::make_heap(_heap.begin(), _heap.begin() + _jobCount, runsLater);
+}
+
+void JobScheduler::run()
+{
+    // Nothing to schedule. If the task is ever resumed, check again instead of
+    // reading the empty heap
+    if(_jobCount == 0) {
+        vTaskSuspend(nullptr);
+        return;
+    }
+
+    // Earliest release is on top of the heap
+    Job* const job = _heap[0];
+    const TickType_t now = xTaskGetTickCount();
+    const int32_t wait = static_cast<int32_t>(job->_nextRelease - now);
+    if(wait > 0) {
+        vTaskDelay(static_cast<TickType_t>(wait));
+        return;
+    }
+
+    const auto end = _heap.begin() + _jobCount;
+    std::pop_heap(_heap.begin(), end, runsLater);
+    job->dispatch(now);
+    std::push_heap(_heap.begin(), end, runsLater);
+}
+
+} // namespace SBT::System
@@ -0,0 +1,112 @@
+#ifndef SBT_SYSTEM_JOBSCHEDULER_HPP
+#define SBT_SYSTEM_JOBSCHEDULER_HPP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "Task.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Maximal number of jobs in one JobScheduler
+#ifndef SBT_MAX_JOBS
+#define SBT_MAX_JOBS 16
+#endif
+
+namespace SBT::System {
+
+// Small periodic activity run to completion by a JobScheduler. Jobs of one
+// scheduler share its task and stack, so run() must not block - a blocked job
+// delays all others.
+// Create object derived from Job, configure it using Job's constructor,
+// implement run() and optionally initialize(), then add it to a scheduler.
+class Job {
+public:
+    // Times in ticks are measured from the scheduler's start, execution times
+    // with the DWT cycle counter. Lateness is the delay of a start after the
+    // release time, caused by other jobs of the scheduler.
+    struct Statistics {
+        uint32_t runs;
+        // Runs which ended after the next release time
+        uint32_t overruns;
+        uint32_t skippedReleases;
+        uint32_t latenessMaxMs;
+        uint32_t executionMaxUs;
+        uint32_t executionMeanUs;
+    };
+
+    // Name is not copied and has to outlive the job, e.g. a string literal.
+    // Priority orders jobs released at the same tick, higher runs first.
+    // First release is 'offset' ms after the scheduler starts, then every
+    // 'period' ms.
+    Job(const char* name, uint8_t priority, uint32_t period,
+        uint32_t offset = 0);
+    virtual ~Job() = default;
+
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    [[nodiscard]] const char* getName() const { return _name; }
+    [[nodiscard]] uint8_t getPriority() const { return _priority; }
+    [[nodiscard]] uint32_t getPeriod() const { return _period; }
+
+    // Safe to call from any task
+    [[nodiscard]] Statistics getStatistics() const;
+
+    // Setup method that is run single time when the scheduler starts
+    virtual void initialize() {}
+
+    // Method that is called once per 'period' milliseconds
+    virtual void run() = 0;
+
+private:
+    void dispatch(TickType_t now);
+
+    const char* const _name;
+    const uint8_t _priority;
+    const uint32_t _period;
+    const uint32_t _offset;
+
+    // Touched only by the scheduler's task
+    TickType_t _nextRelease = 0;
+
+    // Raw statistics, guarded by critical section
+    uint32_t _runs = 0;
+    uint32_t _overruns = 0;
+    uint32_t _skippedReleases = 0;
+    uint32_t _latenessMax = 0;
+    uint32_t _executionMax = 0;
+    uint64_t _executionSum = 0;
+
+    friend class JobScheduler;
+};
+
+// Task which runs many jobs on one stack. Pending jobs are kept in a min-heap
+// ordered by the next release time, so dispatch costs O(log n) and the task
+// sleeps until the earliest release. Missed releases of a late job are
+// skipped, not caught up.
+// Jobs have to be added before the scheduler starts, register the scheduler
+// in TaskManager like any other task.
+class JobScheduler : public Task {
+public:
+    JobScheduler(const char* name, size_t priority, size_t stackDepth);
+
+    void addJob(Job& job);
+
+    void initialize() override;
+    void run() override;
+
+private:
+    // Heap order - true if 'a' should run after 'b'
+    static bool runsLater(const Job* a, const Job* b);
+
+    std::array<Job*, SBT_MAX_JOBS> _heap{};
+    size_t _jobCount = 0;
+    bool _started = false;
+};
+
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_JOBSCHEDULER_HPP
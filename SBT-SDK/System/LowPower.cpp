@@ -0,0 +1,155 @@
+#include "LowPower.hpp"
+
+#include "task.h"
+
+#include "CycleCounter.hpp"
+
+#ifdef SBT_TASK_SUPERVISOR
+#include "TaskSupervisor.hpp"
+#endif
+
+namespace SBT::System {
+
+namespace {
+IWDG_HandleTypeDef* watchdog = nullptr;
+// Longest sleep which keeps the watchdog refreshed in time
+uint32_t maxIdleTicks = portMAX_DELAY;
+
+// Touched by the idle task with interrupts disabled, read under critical
+// section
+uint32_t sleeps = 0;
+uint32_t sleptTicks = 0;
+uint32_t wakeCycles = 0;
+// Cycle counter and SysTick counter when the core went to sleep
+uint32_t sleepCycles = 0;
+uint32_t sleepSysTick = 0;
+// Set after a sleep woken by CAN RX until the core sleeps again or a CAN
+// message is handled
+bool wakePending = false;
+
+// Guarded by critical section
+uint32_t canWakeUps = 0;
+uint32_t canWakeLatencyMax = 0;
+uint64_t canWakeLatencySum = 0;
+} // namespace
+
+void LowPower::Initialize(IWDG_HandleTypeDef* _watchdog,
+                          unsigned watchdogTimeout_ms)
+{
+    Hardware::CycleCounter::Enable();
+
+    watchdog = _watchdog;
+    if(watchdog != nullptr) {
+        maxIdleTicks = watchdogTimeout_ms / 2 * configTICK_RATE_HZ / 1000;
+        // Shorter sleeps are not started by the kernel anyway
+        if(maxIdleTicks < configEXPECTED_IDLE_TIME_BEFORE_SLEEP)
+            maxIdleTicks = configEXPECTED_IDLE_TIME_BEFORE_SLEEP;
+    }
+
+#ifdef SBT_DEBUG
+    // Keep the debugger connected while the core sleeps
+    HAL_DBGMCU_EnableDBGSleepMode();
+#endif
+}
+
+void LowPower::CanMessageHandled()
+{
+    taskENTER_CRITICAL();
+    if(wakePending) {
+        wakePending = false;
+        const uint32_t latency = Hardware::CycleCounter::Get() - wakeCycles;
+        canWakeUps++;
+        canWakeLatencySum += latency;
+        if(latency > canWakeLatencyMax)
+            canWakeLatencyMax = latency;
+    }
+    taskEXIT_CRITICAL();
+}
+
+LowPower::Statistics LowPower::GetStatistics()
+{
+    taskENTER_CRITICAL();
+    const uint32_t sleepCount = sleeps;
+    const uint32_t slept = sleptTicks;
+    const uint32_t wakeUps = canWakeUps;
+    const uint32_t latencyMax = canWakeLatencyMax;
+    const uint64_t latencySum = canWakeLatencySum;
+    taskEXIT_CRITICAL();
+
+    using Hardware::CycleCounter;
+    Statistics stats{};
+    stats.sleeps = sleepCount;
+    stats.sleptMs = slept * 1000 / configTICK_RATE_HZ;
+    stats.canWakeUps = wakeUps;
+    if(wakeUps != 0) {
+        stats.canWakeLatencyMaxUs = CycleCounter::ToMicroseconds(latencyMax);
+        stats.canWakeLatencyMeanUs = CycleCounter::ToMicroseconds(
+            static_cast<uint32_t>(latencySum / wakeUps));
+    }
+    return stats;
+}
+
+} // namespace SBT::System
+
+extern "C" {
+// Hooks of the port's vPortSuppressTicksAndSleep(), see FreeRTOSConfig.h. All
+// are called by the idle task with interrupts disabled.
+
+uint32_t ulLimitIdleTime(uint32_t expectedIdleTime)
+{
+    using namespace SBT::System;
+    return expectedIdleTime < maxIdleTicks ? expectedIdleTime : maxIdleTicks;
+}
+
+void vPreSleepProcessing(uint32_t)
+{
+    using namespace SBT::System;
+#ifdef SBT_TASK_SUPERVISOR
+    TaskSupervisor::RefreshFromISR();
+#else
+    if(watchdog != nullptr)
+        HAL_IWDG_Refresh(watchdog);
+#endif
+    wakePending = false;
+    // The port has just loaded SysTick with the whole sleep
+    sleepSysTick = SysTick->VAL;
+    sleepCycles = SBT::Hardware::CycleCounter::Get();
+}
+
+void vPostSleepProcessing(uint32_t)
+{
+    using namespace SBT::System;
+    using SBT::Hardware::CycleCounter;
+
+    // SysTick runs on the core clock while the core sleeps, the cycle counter
+    // does not (unless a debugger keeps it running). The tick interrupt is
+    // not taken yet, so SysTick reloaded at most once - when it is pending or
+    // when it counts above its value before the sleep.
+    const bool pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    const uint32_t sysTick = SysTick->VAL;
+    const uint32_t counted = CycleCounter::Get() - sleepCycles;
+    const uint32_t elapsed = pending || sysTick > sleepSysTick
+                                 ? sleepSysTick + SysTick->LOAD + 1 - sysTick
+                                 : sleepSysTick - sysTick;
+    // Add what the counter missed, so Time::GetCycles(), run time stats and
+    // wake-up latencies include the sleep
+    if(elapsed > counted)
+        CycleCounter::Advance(elapsed - counted);
+
+    wakeCycles = CycleCounter::Get();
+    // Only sleeps ended by a received frame count for the CAN wake-up
+    // latency. Interrupts are still masked, so the RX interrupt is pending.
+    wakePending = HAL_NVIC_GetPendingIRQ(USB_LP_CAN1_RX0_IRQn) != 0 ||
+                  HAL_NVIC_GetPendingIRQ(CAN1_RX1_IRQn) != 0;
+    sleeps++;
+}
+
+// Called by vTaskStepTick() with the number of suppressed ticks
+void vTickStepped(uint32_t ticks)
+{
+    using namespace SBT::System;
+    // Same increment as HAL_IncTick() per tick
+    uwTick += ticks * static_cast<uint32_t>(uwTickFreq);
+    sleptTicks += ticks;
+}
+}
@@ -0,0 +1,58 @@
+#ifndef SBT_SYSTEM_LOWPOWER_HPP
+#define SBT_SYSTEM_LOWPOWER_HPP
+
+#include "FreeRTOS.h"
+
+#include <cstdint>
+#include <stm32f1xx_hal.h>
+
+namespace SBT::System {
+/**
+ * @brief Tickless idle, enabled by SBT_TICKLESS_IDLE. When all tasks are
+ * blocked the idle task stops SysTick until the next task deadline and sleeps
+ * the core with WFI (see FreeRTOSConfig.h). Sleep mode keeps peripheral
+ * clocks running, so any enabled interrupt - CAN RX included - wakes the core.
+ * Stop mode is not used, it would stop HSE and with it the CAN controller.
+ *
+ * The watchdog is refreshed before every sleep (with SBT_TASK_SUPERVISOR only
+ * if all supervised tasks checked in) and a sleep is limited to half of the
+ * watchdog timeout. Suppressed ticks are added to the HAL tick, so
+ * HAL_GetTick() and HAL timeouts stay valid. The cycle counter stops during a
+ * sleep; the cycles it missed are measured with SysTick, to the cycle, and
+ * added to it after the sleep, so Time::GetCycles() and the run time stats
+ * (SBT_RUNTIME_STATS) count real time.
+ */
+class LowPower {
+public:
+    struct Statistics {
+        uint32_t sleeps;
+        // Total time with the tick suppressed
+        uint32_t sleptMs;
+        // Sleeps woken by a received CAN frame
+        uint32_t canWakeUps;
+        // Time from the core waking up to the CAN callback being called
+        uint32_t canWakeLatencyMaxUs;
+        uint32_t canWakeLatencyMeanUs;
+    };
+
+    LowPower() = delete;
+
+    /**
+     * @brief Has to be called before vTaskStartScheduler(), done by
+     * System::Start().
+     * @param watchdog started watchdog, nullptr if disabled
+     * @param watchdogTimeout_ms timeout the watchdog was started with
+     */
+    static void Initialize(IWDG_HandleTypeDef* watchdog,
+                           unsigned watchdogTimeout_ms);
+
+    /**
+     * @brief Called by CanReceiver before calling a user callback
+     */
+    static void CanMessageHandled();
+
+    [[nodiscard]] static Statistics GetStatistics();
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_LOWPOWER_HPP
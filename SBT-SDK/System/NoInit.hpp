@@ -0,0 +1,15 @@
+#ifndef SBT_SYSTEM_NOINIT_HPP
+#define SBT_SYSTEM_NOINIT_HPP
+
+/**
+ * @brief Place a variable in the .noinit section, which keeps its value across
+ * a reset. Startup code zeroes only .bss, so the linker script has to place
+ * .noinit in RAM outside of it, e.g.
+ *     .noinit (NOLOAD) : { *(.noinit*) } >RAM
+ * Contents are random after power-on - validate them, e.g. with a magic
+ * number written together with the data.
+ * @example SBT_NOINIT static Record record;
+ */
+#define SBT_NOINIT __attribute__((section(".noinit")))
+
+#endif // SBT_SYSTEM_NOINIT_HPP
@@ -0,0 +1,89 @@
+#ifndef SBT_SYSTEM_RINGBUFFER_HPP
+#define SBT_SYSTEM_RINGBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace SBT::System {
+/**
+ * @brief Fixed capacity FIFO for one producer and one consumer, e.g. an
+ * interrupt and a task. Push() and Pop() never block and need no lock, as
+ * long as each of them is called from one context only. Several producers
+ * have to serialise Push() themselves, e.g. with a critical section.
+ * @tparam T element type, copied in and out
+ * @tparam Capacity maximal number of stored elements
+ */
+template <typename T, size_t Capacity> class RingBuffer {
+    static_assert(Capacity > 0, "RingBuffer capacity has to be positive");
+
+    // One slot stays empty to tell a full buffer from an empty one
+    static constexpr size_t slotCount = Capacity + 1;
+
+    static constexpr size_t Next(size_t index)
+    {
+        return index + 1 == slotCount ? 0 : index + 1;
+    }
+
+public:
+    /**
+     * @brief Add element, producer side
+     * @return false if the buffer is full
+     */
+    bool Push(const T& item)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        const size_t next = Next(head);
+        if(next == _tail.load(std::memory_order_acquire))
+            return false;
+
+        _items[head] = item;
+        _head.store(next, std::memory_order_release);
+
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        const size_t count = next >= tail ? next - tail
+                                          : next + slotCount - tail;
+        if(count > _highWaterMark.load(std::memory_order_relaxed))
+            _highWaterMark.store(count, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest element, consumer side
+     * @return false if the buffer is empty
+     */
+    bool Pop(T& item)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if(tail == _head.load(std::memory_order_acquire))
+            return false;
+
+        item = _items[tail];
+        _tail.store(Next(tail), std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool IsEmpty() const
+    {
+        return _tail.load(std::memory_order_acquire) ==
+               _head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Highest number of stored elements seen by Push(), Capacity
+     * means the buffer was full at least once
+     */
+    [[nodiscard]] size_t GetHighWaterMark() const
+    {
+        return _highWaterMark.load(std::memory_order_relaxed);
+    }
+
+private:
+    T _items[slotCount];
+    std::atomic<size_t> _head{0};
+    std::atomic<size_t> _tail{0};
+    // Written by the producer only
+    std::atomic<size_t> _highWaterMark{0};
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_RINGBUFFER_HPP
@@ -0,0 +1,135 @@
+#include "RuntimeStats.hpp"
+
+#include "task.h"
+
+#include "CycleCounter.hpp"
+#include "Error.hpp"
+#include "TaskManager.hpp"
+
+extern "C" {
+// Called by vTaskStartScheduler(), see FreeRTOSConfig.h
+void vConfigureTimerForRunTimeStats(void)
+{
+    SBT::Hardware::CycleCounter::Enable();
+}
+}
+
+namespace SBT::System {
+
+namespace {
+// Registered tasks plus idle and timer tasks
+constexpr size_t maxTasks = SBT_MAX_TASKS + 2;
+
+struct Sample {
+    UBaseType_t number;
+    uint32_t runTime;
+};
+
+// Touched only by Update()
+TaskStatus_t status[maxTasks];
+Sample previous[maxTasks];
+size_t previousCount = 0;
+uint32_t previousTotal = 0;
+RuntimeStats::TaskLoad pending[maxTasks];
+
+// Results of the last window, guarded by critical section. Task names point
+// into TCBs, tasks are never deleted.
+RuntimeStats::TaskLoad loads[maxTasks];
+size_t loadCount = 0;
+size_t taskCount = 0;
+uint8_t idleLoad = 0;
+
+uint8_t ToPercent(uint32_t runTime, uint32_t window)
+{
+    const uint64_t percent =
+        (static_cast<uint64_t>(runTime) * 100 + window / 2) / window;
+    return percent > 100 ? 100 : static_cast<uint8_t>(percent);
+}
+} // namespace
+
+void RuntimeStats::Update()
+{
+    uint32_t total = 0;
+    const UBaseType_t count = uxTaskGetSystemState(status, maxTasks, &total);
+    if(count == 0)
+        // More tasks than SBT_MAX_TASKS + 2
+        softfault({ErrorModule::RuntimeStats, ErrorCode::CapacityExceeded,
+                   __LINE__,
+                   static_cast<uint32_t>(uxTaskGetNumberOfTasks())});
+
+    // Counters are 32-bit cycle counts, differences are correct across a
+    // single wrap around
+    const uint32_t window = total - previousTotal;
+    if(window == 0)
+        return;
+
+    const TaskHandle_t idleHandle = xTaskGetIdleTaskHandle();
+    uint8_t newIdleLoad = 0;
+    size_t pendingCount = 0;
+
+    for(UBaseType_t i = 0; i < count; i++) {
+        // Task created during the window counts from zero
+        uint32_t last = 0;
+        for(size_t j = 0; j < previousCount; j++) {
+            if(previous[j].number == status[i].xTaskNumber) {
+                last = previous[j].runTime;
+                break;
+            }
+        }
+
+        const uint8_t load =
+            ToPercent(status[i].ulRunTimeCounter - last, window);
+        if(status[i].xHandle == idleHandle) {
+            newIdleLoad = load;
+            continue;
+        }
+
+        // Insertion sort, highest load first
+        size_t k = pendingCount++;
+        for(; k > 0 && pending[k - 1].load < load; k--)
+            pending[k] = pending[k - 1];
+        pending[k] = {static_cast<uint8_t>(status[i].xTaskNumber), load,
+                      status[i].pcTaskName};
+    }
+
+    for(UBaseType_t i = 0; i < count; i++)
+        previous[i] = {status[i].xTaskNumber, status[i].ulRunTimeCounter};
+    previousCount = count;
+    previousTotal = total;
+
+    taskENTER_CRITICAL();
+    for(size_t i = 0; i < pendingCount; i++)
+        loads[i] = pending[i];
+    loadCount = pendingCount;
+    taskCount = count;
+    idleLoad = newIdleLoad;
+    taskEXIT_CRITICAL();
+}
+
+uint8_t RuntimeStats::GetIdleLoad()
+{
+    taskENTER_CRITICAL();
+    const uint8_t copy = idleLoad;
+    taskEXIT_CRITICAL();
+    return copy;
+}
+
+size_t RuntimeStats::GetTaskCount()
+{
+    taskENTER_CRITICAL();
+    const size_t copy = taskCount;
+    taskEXIT_CRITICAL();
+    return copy;
+}
+
+size_t RuntimeStats::GetTopConsumers(TaskLoad* top, size_t count)
+{
+    taskENTER_CRITICAL();
+    const size_t copied = count < loadCount ? count : loadCount;
+    for(size_t i = 0; i < copied; i++)
+        top[i] = loads[i];
+    taskEXIT_CRITICAL();
+    return copied;
+}
+
+} // namespace SBT::System
@@ -0,0 +1,65 @@
+#ifndef SBT_SYSTEM_RUNTIMESTATS_HPP
+#define SBT_SYSTEM_RUNTIMESTATS_HPP
+
+#include "FreeRTOS.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SBT::System {
+/**
+ * @brief Per-task CPU load measured by FreeRTOS run time stats. Requires
+ * SBT_RUNTIME_STATS, which makes the kernel read the DWT cycle counter on
+ * every context switch.
+ *
+ * Loads are computed over the window between two consecutive Update() calls
+ * (Heartbeat calls it every second). The cycle counter wraps around after
+ * ~59 s at 72 MHz, so the window has to be shorter than that.
+ *
+ * The counter stops while the core sleeps in tickless idle (SBT_TICKLESS_IDLE).
+ * LowPower advances it by the slept cycles before the idle task is switched
+ * out, so sleeps count as idle time.
+ */
+class RuntimeStats {
+    static_assert(configGENERATE_RUN_TIME_STATS == 1,
+                  "RuntimeStats requires SBT_RUNTIME_STATS");
+
+public:
+    struct TaskLoad {
+        // FreeRTOS task number, unique and assigned in creation order
+        uint8_t number;
+        // Share of CPU time in the last window, in percent
+        uint8_t load;
+        const char* name;
+    };
+
+    RuntimeStats() = delete;
+
+    /**
+     * @brief Take a sample of run time counters of all tasks and close the
+     * current window. Should be called periodically from one task.
+     */
+    static void Update();
+
+    /**
+     * @brief Idle task share of CPU time in the last window, in percent
+     */
+    [[nodiscard]] static uint8_t GetIdleLoad();
+
+    /**
+     * @brief Number of tasks (including idle) seen in the last window
+     */
+    [[nodiscard]] static size_t GetTaskCount();
+
+    /**
+     * @brief Copy tasks with the highest load in the last window, idle task
+     * excluded
+     * @param top destination, sorted by load, highest first
+     * @param count size of top
+     * @return number of entries written
+     */
+    static size_t GetTopConsumers(TaskLoad* top, size_t count);
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_RUNTIMESTATS_HPP
@@ -0,0 +1,280 @@
+#include "Schedulability.hpp"
+
+#include "task.h"
+
+#include "Error.hpp"
+#include "UART.hpp"
+
+#include <cstdio>
+
+namespace SBT::System {
+
+namespace {
+// Fixed-point iterations before a response time is given up as unbounded
+constexpr size_t maxIterations = 1000;
+
+struct TaskDeclaration {
+    const Task* task;
+    uint32_t periodUs;
+    uint32_t budgetUs;
+};
+
+struct Interrupt {
+    const char* name;
+    uint32_t periodUs;
+    uint32_t budgetUs;
+};
+
+// Written before the scheduler starts or by the analysing task
+TaskDeclaration taskDeclarations[SBT_MAX_TASKS];
+size_t taskDeclarationCount = 0;
+Interrupt interrupts[SBT_MAX_INTERRUPTS];
+size_t interruptCount = 0;
+
+// Longest measured execution, written by interrupts
+volatile uint32_t interruptCyclesMax[SBT_MAX_INTERRUPTS];
+
+// Touched only by Analyse()
+Schedulability::Result pending[SBT_MAX_TASKS];
+uint32_t interruptExecutionUs[SBT_MAX_INTERRUPTS];
+
+// Results of the last Analyse(), guarded by critical section
+Schedulability::Result results[SBT_MAX_TASKS];
+size_t resultCount = 0;
+uint32_t reportedExecutionUs[SBT_MAX_INTERRUPTS];
+
+uint64_t Interference(uint64_t window, uint32_t periodUs, uint32_t executionUs)
+{
+    return (window + periodUs - 1) / periodUs * executionUs;
+}
+
+const char* SourceName(Schedulability::Source source)
+{
+    switch(source) {
+    case Schedulability::Source::Declared:
+        return "declared";
+    case Schedulability::Source::Measured:
+        return "measured";
+    default:
+        return "unknown";
+    }
+}
+
+Schedulability::Result Collect(const Task& task)
+{
+    Schedulability::Result result{};
+    result.name = task.getName();
+    result.priority = static_cast<uint8_t>(task.getPriority());
+
+    for(size_t i = 0; i < taskDeclarationCount; i++) {
+        if(taskDeclarations[i].task != &task)
+            continue;
+        result.source = Schedulability::Source::Declared;
+        result.periodUs = taskDeclarations[i].periodUs;
+        result.executionUs = taskDeclarations[i].budgetUs;
+        return result;
+    }
+
+    const Task::Timing timing = task.getTiming();
+    result.periodUs = timing.periodUs;
+    result.executionUs = timing.executionMaxUs;
+    if(timing.periodUs != 0 && timing.executionMaxUs != 0)
+        result.source = Schedulability::Source::Measured;
+    return result;
+}
+
+void ComputeResponseTime(Schedulability::Result& result, size_t index,
+                         size_t count)
+{
+    result.complete = true;
+
+    uint64_t response = result.executionUs;
+    bool converged = false;
+    for(size_t iteration = 0; iteration < maxIterations; iteration++) {
+        uint64_t next = result.executionUs;
+        for(size_t i = 0; i < interruptCount; i++)
+            next += Interference(response, interrupts[i].periodUs,
+                                 interruptExecutionUs[i]);
+
+        // Equal priority tasks are not time sliced, any of them may run first
+        for(size_t i = 0; i < count; i++) {
+            const Schedulability::Result& other = pending[i];
+            if(i == index || other.priority < result.priority)
+                continue;
+            if(other.source == Schedulability::Source::Unknown) {
+                result.complete = false;
+                continue;
+            }
+            next += Interference(response, other.periodUs, other.executionUs);
+        }
+
+        if(next == response) {
+            converged = true;
+            break;
+        }
+        response = next;
+        if(response > result.periodUs)
+            break;
+    }
+
+    result.schedulable = converged && response <= result.periodUs;
+    result.responseUs =
+        response > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(response);
+    const int64_t margin = static_cast<int64_t>(result.periodUs) -
+                           static_cast<int64_t>(response);
+    result.marginUs = margin < INT32_MIN ? INT32_MIN
+                                         : static_cast<int32_t>(margin);
+}
+} // namespace
+
+void Schedulability::DeclareTask(const Task& task, uint32_t periodUs,
+                                 uint32_t budgetUs)
+{
+    if(periodUs == 0)
+        softfault({ErrorModule::Schedulability, ErrorCode::InvalidArgument,
+                   __LINE__, periodUs});
+
+    for(size_t i = 0; i < taskDeclarationCount; i++) {
+        if(taskDeclarations[i].task == &task) {
+            taskDeclarations[i] = {&task, periodUs, budgetUs};
+            return;
+        }
+    }
+
+    if(taskDeclarationCount >= SBT_MAX_TASKS)
+        // Increase SBT_MAX_TASKS
+        softfault({ErrorModule::Schedulability, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_TASKS});
+    taskDeclarations[taskDeclarationCount++] = {&task, periodUs, budgetUs};
+}
+
+size_t Schedulability::DeclareInterrupt(const char* name, uint32_t periodUs,
+                                        uint32_t budgetUs)
+{
+    if(periodUs == 0)
+        softfault({ErrorModule::Schedulability, ErrorCode::InvalidArgument,
+                   __LINE__, periodUs});
+    if(interruptCount >= SBT_MAX_INTERRUPTS)
+        // Increase SBT_MAX_INTERRUPTS
+        softfault({ErrorModule::Schedulability, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_INTERRUPTS});
+
+    Hardware::CycleCounter::Enable();
+    interrupts[interruptCount] = {name, periodUs, budgetUs};
+    return interruptCount++;
+}
+
+void Schedulability::RecordInterrupt(size_t id, uint32_t cycles)
+{
+    // Interrupts of one id do not preempt each other
+    if(cycles > interruptCyclesMax[id])
+        interruptCyclesMax[id] = cycles;
+}
+
+bool Schedulability::Analyse()
+{
+    for(size_t i = 0; i < interruptCount; i++) {
+        const uint32_t measured =
+            Hardware::CycleCounter::ToMicroseconds(interruptCyclesMax[i]) + 1;
+        interruptExecutionUs[i] = interruptCyclesMax[i] == 0 ? 0 : measured;
+        if(interrupts[i].budgetUs > interruptExecutionUs[i])
+            interruptExecutionUs[i] = interrupts[i].budgetUs;
+    }
+
+    // Sort by priority, highest first
+    const size_t count = TaskManager::getTaskCount();
+    for(size_t i = 0; i < count; i++) {
+        const Result result = Collect(TaskManager::getTask(i));
+        size_t position = i;
+        while(position > 0 &&
+              pending[position - 1].priority < result.priority) {
+            pending[position] = pending[position - 1];
+            position--;
+        }
+        pending[position] = result;
+    }
+
+    bool schedulable = true;
+    for(size_t i = 0; i < count; i++) {
+        Result& result = pending[i];
+        if(result.source == Source::Unknown)
+            continue;
+        ComputeResponseTime(result, i, count);
+        if(!result.schedulable)
+            schedulable = false;
+    }
+
+    taskENTER_CRITICAL();
+    for(size_t i = 0; i < count; i++)
+        results[i] = pending[i];
+    resultCount = count;
+    for(size_t i = 0; i < interruptCount; i++)
+        reportedExecutionUs[i] = interruptExecutionUs[i];
+    taskEXIT_CRITICAL();
+
+    return schedulable;
+}
+
+size_t Schedulability::GetResults(Result* destination, size_t count)
+{
+    taskENTER_CRITICAL();
+    const size_t copied = count < resultCount ? count : resultCount;
+    for(size_t i = 0; i < copied; i++)
+        destination[i] = results[i];
+    taskEXIT_CRITICAL();
+    return copied;
+}
+
+void Schedulability::Report(Hardware::UART& uart)
+{
+    // Buffer has to stay untouched until the previous transmission completes
+    static char line[192];
+    static Result copy[SBT_MAX_TASKS];
+    static uint32_t executionUs[SBT_MAX_INTERRUPTS];
+
+    taskENTER_CRITICAL();
+    for(size_t i = 0; i < interruptCount; i++)
+        executionUs[i] = reportedExecutionUs[i];
+    taskEXIT_CRITICAL();
+
+    const auto send = [](Hardware::UART& uart, int length) {
+        if(length > 0 && static_cast<size_t>(length) < sizeof(line))
+            uart.Send(reinterpret_cast<uint8_t*>(line),
+                      static_cast<size_t>(length));
+    };
+
+    for(size_t i = 0; i < interruptCount; i++) {
+        while(!uart.IsTxComplete()) {
+        }
+        send(uart, snprintf(line, sizeof(line),
+                            "{\"isr\":\"%s\",\"period\":%lu,"
+                            "\"execution\":%lu}\n",
+                            interrupts[i].name,
+                            static_cast<unsigned long>(interrupts[i].periodUs),
+                            static_cast<unsigned long>(executionUs[i])));
+    }
+
+    const size_t count = GetResults(copy, SBT_MAX_TASKS);
+    for(size_t i = 0; i < count; i++) {
+        const Result& result = copy[i];
+        while(!uart.IsTxComplete()) {
+        }
+        send(uart,
+             snprintf(line, sizeof(line),
+                      "{\"task\":\"%s\",\"priority\":%u,\"source\":\"%s\","
+                      "\"period\":%lu,\"execution\":%lu,\"response\":%lu,"
+                      "\"margin\":%ld,\"schedulable\":%s,\"complete\":%s}\n",
+                      result.name, result.priority, SourceName(result.source),
+                      static_cast<unsigned long>(result.periodUs),
+                      static_cast<unsigned long>(result.executionUs),
+                      static_cast<unsigned long>(result.responseUs),
+                      static_cast<long>(result.marginUs),
+                      result.schedulable ? "true" : "false",
+                      result.complete ? "true" : "false"));
+    }
+
+    while(!uart.IsTxComplete()) {
+    }
+}
+
+} // namespace SBT::System
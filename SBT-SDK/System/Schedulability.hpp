@@ -0,0 +1,135 @@
+#ifndef SBT_SYSTEM_SCHEDULABILITY_HPP
+#define SBT_SYSTEM_SCHEDULABILITY_HPP
+
+#include "FreeRTOS.h"
+
+#include "CycleCounter.hpp"
+#include "TaskManager.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Maximal number of interrupts declared in Schedulability
+#ifndef SBT_MAX_INTERRUPTS
+#define SBT_MAX_INTERRUPTS 8
+#endif
+
+namespace SBT::Hardware {
+class UART;
+}
+
+namespace SBT::System {
+/**
+ * @brief Response-time analysis of tasks registered in TaskManager, enabled by
+ * SBT_SCHEDULABILITY. Worst-case response time of a task is the fixed point of
+ *     R = C + sum over interrupts and tasks of higher or equal priority of
+ *         ceil(R / T) * C
+ * where C is the worst-case execution time and T the period (or minimal
+ * inter-arrival time). A task is schedulable if R does not exceed its period,
+ * margin is the difference.
+ *
+ * Timing of a task is its declared budget (DeclareTask()) or, for a
+ * PeriodicTask, its measured period and longest run(). Measured times include
+ * preemption, so the result is pessimistic. Tasks with neither, e.g. event
+ * driven tasks without a declared budget, are not analysed and results of
+ * lower priority tasks are marked incomplete.
+ *
+ * Interrupts are declared with a minimal inter-arrival time and a budget, their
+ * execution time is also measured by InterruptProbe; the larger one is used.
+ * System::Start() declares SysTick and CAN interrupts and analyses declared
+ * budgets before the scheduler starts - with SBT_DEBUG an unschedulable task
+ * set is a softfault.
+ */
+class Schedulability {
+public:
+    enum class Source : uint8_t {
+        // Not analysed
+        Unknown,
+        Declared,
+        Measured
+    };
+
+    struct Result {
+        const char* name;
+        uint8_t priority;
+        Source source;
+        uint32_t periodUs;
+        uint32_t executionUs;
+        // Worst-case response time, larger than periodUs if not schedulable
+        uint32_t responseUs;
+        // periodUs - responseUs, negative if not schedulable
+        int32_t marginUs;
+        bool schedulable;
+        // False if a task which can preempt this one was not analysed
+        bool complete;
+    };
+
+    // Measures execution time of an interrupt handler from construction to
+    // destruction
+    class InterruptProbe {
+    public:
+        explicit InterruptProbe(size_t id)
+            : _id(id), _start(Hardware::CycleCounter::Get())
+        {
+        }
+        ~InterruptProbe()
+        {
+            RecordInterrupt(_id, Hardware::CycleCounter::Get() - _start);
+        }
+
+    private:
+        const size_t _id;
+        const uint32_t _start;
+    };
+
+    Schedulability() = delete;
+
+    /**
+     * @brief Declare timing of a task, overrides measured values
+     * @param periodUs period or minimal time between two releases
+     * @param budgetUs worst-case execution time
+     */
+    static void DeclareTask(const Task& task, uint32_t periodUs,
+                            uint32_t budgetUs);
+
+    /**
+     * @brief Declare an interrupt, has to be called before the scheduler
+     * starts
+     * @param name not copied, e.g. a string literal
+     * @param periodUs minimal time between two interrupts
+     * @param budgetUs worst-case execution time, 0 to use the measured time
+     * @return id for InterruptProbe
+     */
+    static size_t DeclareInterrupt(const char* name, uint32_t periodUs,
+                                   uint32_t budgetUs);
+
+    // Keep the longest execution of an interrupt, called by InterruptProbe
+    static void RecordInterrupt(size_t id, uint32_t cycles);
+
+    /**
+     * @brief Collect timing of all tasks and compute their response times.
+     * Call from one task at a time.
+     * @return true if all analysed tasks are schedulable
+     */
+    static bool Analyse();
+
+    /**
+     * @brief Copy results of the last Analyse(), highest priority first
+     * @return number of results written
+     */
+    static size_t GetResults(Result* results, size_t count);
+
+    /**
+     * @brief Send results of the last Analyse() as JSON lines, one per
+     * interrupt and task:
+     * {"isr":"SysTick","period":1000,"execution":3}
+     * {"task":"Heartbeat","priority":9,"source":"measured","period":1000000,
+     * "execution":120,"response":410,"margin":999590,"schedulable":true,
+     * "complete":true}
+     * Blocks until transmission completes.
+     */
+    static void Report(Hardware::UART& uart);
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_SCHEDULABILITY_HPP
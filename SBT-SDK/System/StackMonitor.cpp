@@ -0,0 +1,167 @@
+#include "StackMonitor.hpp"
+
+#include "task.h"
+
+#include "TaskManager.hpp"
+#include "UART.hpp"
+
+#include <cstdio>
+#include <stm32f1xx_hal.h>
+
+// Defined by the linker script
+extern "C" uint32_t _estack;
+extern "C" uint32_t _Min_Stack_Size;
+
+namespace SBT::System {
+
+namespace {
+// Same pattern FreeRTOS fills task stacks with (tskSTACK_FILL_BYTE)
+constexpr uint32_t paintPattern = 0xA5A5A5A5;
+// Words below the stack pointer left unpainted, for the painting loop itself
+constexpr size_t paintGuard = 16;
+
+// Registered tasks and the main stack
+constexpr size_t maxEntries = SBT_MAX_TASKS + 1;
+
+// Results of the last Sample(), guarded by critical section
+StackMonitor::Entry entries[maxEntries];
+size_t entryCount = 0;
+
+// Touched only by Sample()
+StackMonitor::Entry sampled[maxEntries];
+bool alerted[maxEntries];
+StackMonitor::AlertCallback alertCallback = nullptr;
+
+uint32_t* MainStackBottom()
+{
+    return reinterpret_cast<uint32_t*>(
+        reinterpret_cast<uintptr_t>(&_estack) -
+        reinterpret_cast<uintptr_t>(&_Min_Stack_Size));
+}
+
+size_t MainStackSize()
+{
+    return reinterpret_cast<uintptr_t>(&_Min_Stack_Size) / sizeof(uint32_t);
+}
+
+StackMonitor::Entry MakeEntry(const char* name, size_t size, size_t used)
+{
+    size_t recommended = (used * (100 + SBT_STACK_MARGIN_PERCENT) + 99) / 100;
+    if(recommended < configMINIMAL_STACK_SIZE)
+        recommended = configMINIMAL_STACK_SIZE;
+
+    return {name, static_cast<uint16_t>(size), static_cast<uint16_t>(used),
+            static_cast<uint16_t>(recommended)};
+}
+} // namespace
+
+void StackMonitor::PaintMainStack()
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Interrupts would push their frames into the painted area
+    auto* const end = reinterpret_cast<uint32_t*>(__get_MSP()) - paintGuard;
+    for(uint32_t* word = MainStackBottom(); word < end; word++)
+        *word = paintPattern;
+
+    __set_PRIMASK(primask);
+}
+
+void StackMonitor::Sample()
+{
+    const size_t taskCount = TaskManager::getTaskCount();
+    size_t count = 0;
+
+    for(size_t i = 0; i < taskCount; i++) {
+        const Task& task = TaskManager::getTask(i);
+        if(task.getHandle() == nullptr)
+            continue;
+
+        const size_t freeWords = uxTaskGetStackHighWaterMark(task.getHandle());
+        sampled[count++] = MakeEntry(task.getName(), task.getStackDepth(),
+                                     task.getStackDepth() - freeWords);
+    }
+
+    // Main stack is used from the top, first overwritten word from the bottom
+    // marks the deepest usage
+    const uint32_t* const bottom = MainStackBottom();
+    const size_t mainSize = MainStackSize();
+    size_t mainFree = 0;
+    while(mainFree < mainSize && bottom[mainFree] == paintPattern)
+        mainFree++;
+    sampled[count++] = MakeEntry("MSP", mainSize, mainSize - mainFree);
+
+    taskENTER_CRITICAL();
+    for(size_t i = 0; i < count; i++)
+        entries[i] = sampled[i];
+    entryCount = count;
+    taskEXIT_CRITICAL();
+
+    for(size_t i = 0; i < count; i++) {
+        const Entry& entry = sampled[i];
+        const bool overThreshold = static_cast<uint32_t>(entry.used) * 100 >=
+                                   static_cast<uint32_t>(entry.size) *
+                                       SBT_STACK_ALERT_PERCENT;
+        if(!overThreshold || alerted[i])
+            continue;
+
+        alerted[i] = true;
+        if(alertCallback != nullptr)
+            alertCallback(entry);
+    }
+}
+
+void StackMonitor::SetAlertCallback(AlertCallback callback)
+{
+    alertCallback = callback;
+}
+
+size_t StackMonitor::GetEntries(Entry* destination, size_t count)
+{
+    taskENTER_CRITICAL();
+    const size_t copied = count < entryCount ? count : entryCount;
+    for(size_t i = 0; i < copied; i++)
+        destination[i] = entries[i];
+    taskEXIT_CRITICAL();
+    return copied;
+}
+
+StackMonitor::Entry StackMonitor::GetWorstStack()
+{
+    Entry worst{"", 0, 0, 0};
+
+    taskENTER_CRITICAL();
+    for(size_t i = 0; i < entryCount; i++) {
+        const Entry& entry = entries[i];
+        if(i == 0 || entry.size - entry.used < worst.size - worst.used)
+            worst = entry;
+    }
+    taskEXIT_CRITICAL();
+    return worst;
+}
+
+void StackMonitor::Report(Hardware::UART& uart)
+{
+    // Buffer has to stay untouched until the previous transmission completes
+    static char line[96];
+    static Entry copy[maxEntries];
+
+    const size_t count = GetEntries(copy, maxEntries);
+    for(size_t i = 0; i < count; i++) {
+        while(!uart.IsTxComplete()) {
+        }
+        const int length = snprintf(
+            line, sizeof(line),
+            "{\"stack\":\"%s\",\"size\":%u,\"used\":%u,\"recommended\":%u}\n",
+            copy[i].name, copy[i].size, copy[i].used, copy[i].recommended);
+        if(length > 0 && static_cast<size_t>(length) < sizeof(line))
+            uart.Send(reinterpret_cast<uint8_t*>(line),
+                      static_cast<size_t>(length));
+    }
+
+    while(!uart.IsTxComplete()) {
+    }
+}
+
+} // namespace SBT::System
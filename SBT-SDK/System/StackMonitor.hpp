@@ -0,0 +1,90 @@
+#ifndef SBT_SYSTEM_STACKMONITOR_HPP
+#define SBT_SYSTEM_STACKMONITOR_HPP
+
+#include "FreeRTOS.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Recommended stack size is the deepest usage seen plus this margin
+#ifndef SBT_STACK_MARGIN_PERCENT
+#define SBT_STACK_MARGIN_PERCENT 25
+#endif
+
+// Alert fires when usage reaches this percentage of the stack
+#ifndef SBT_STACK_ALERT_PERCENT
+#define SBT_STACK_ALERT_PERCENT 90
+#endif
+
+namespace SBT::Hardware {
+class UART;
+}
+
+namespace SBT::System {
+/**
+ * @brief Tracks the deepest stack usage of all tasks registered in
+ * TaskManager and of the main (MSP) stack used by interrupts. Enabled by
+ * SBT_STACK_MONITOR, sampled every second by Heartbeat.
+ *
+ * Task stacks are filled with a known pattern by FreeRTOS at creation, the
+ * main stack is painted by PaintMainStack() before the scheduler starts.
+ * Usage is the part of the stack where the pattern was overwritten, so it
+ * shows the worst case since reset, not just the moment of sampling. Sizes of
+ * the main stack are taken from _estack and _Min_Stack_Size linker symbols.
+ *
+ * All sizes are in words (StackType_t), like Task stackDepth.
+ */
+class StackMonitor {
+public:
+    struct Entry {
+        // Task name, "MSP" for the main stack
+        const char* name;
+        uint16_t size;
+        uint16_t used;
+        // used + SBT_STACK_MARGIN_PERCENT, at least configMINIMAL_STACK_SIZE
+        uint16_t recommended;
+    };
+
+    // Called from the sampling task when usage of a stack reaches
+    // SBT_STACK_ALERT_PERCENT, once per stack
+    using AlertCallback = void (*)(const Entry& entry);
+
+    StackMonitor() = delete;
+
+    /**
+     * @brief Fill unused part of the main stack with a pattern. Has to be
+     * called before vTaskStartScheduler(), done by System::Start().
+     */
+    static void PaintMainStack();
+
+    /**
+     * @brief Read usage of all stacks and fire alerts
+     */
+    static void Sample();
+
+    static void SetAlertCallback(AlertCallback callback);
+
+    /**
+     * @brief Copy results of the last Sample()
+     * @param entries destination, main stack is the last entry
+     * @param count size of entries
+     * @return number of entries written
+     */
+    static size_t GetEntries(Entry* entries, size_t count);
+
+    /**
+     * @brief Stack with the fewest unused words in the last Sample(), size 0
+     * before the first Sample()
+     */
+    [[nodiscard]] static Entry GetWorstStack();
+
+    /**
+     * @brief Send results of the last Sample() as JSON lines, one per stack:
+     * {"stack":"Heartbeat","size":85,"used":61,"recommended":77}
+     * Blocks until transmission completes.
+     */
+    static void Report(Hardware::UART& uart);
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_STACKMONITOR_HPP
@@ -0,0 +1,54 @@
+#ifndef SBT_SYSTEM_STATICTASK_HPP
+#define SBT_SYSTEM_STATICTASK_HPP
+
+#include "FreeRTOS.h"
+
+#include "Error.hpp"
+#include "Task.hpp"
+
+#include <utility>
+
+namespace SBT::System {
+
+/**
+ * @brief Task with stack and TCB reserved at compile time, so they show up in
+ * the link map and nothing is taken from the FreeRTOS heap. Requires
+ * SBT_STATIC_ALLOCATION (configSUPPORT_STATIC_ALLOCATION).
+ * @tparam T task class derived from Task
+ * @tparam StackDepth stack size in words, by default T::StackDepth. Has to be
+ * at least the stackDepth passed by T to the Task constructor.
+ * @example static StaticTask<MyTask, 128> myTask;
+ * @example TaskManager::registerTask(myTask);
+ */
+template <typename T, size_t StackDepth = T::StackDepth>
+class StaticTask : public T {
+    static_assert(configSUPPORT_STATIC_ALLOCATION == 1,
+                  "StaticTask requires SBT_STATIC_ALLOCATION");
+
+public:
+    template <typename... Args>
+    explicit StaticTask(Args&&... args) : T(std::forward<Args>(args)...)
+    {
+        if(this->getStackDepth() > StackDepth)
+            // Reserved stack is smaller than stackDepth
+            softfault({ErrorModule::TaskManager, ErrorCode::InvalidArgument,
+                       __LINE__,
+                       static_cast<uint32_t>(this->getStackDepth())});
+
+        this->_staticStack = stack;
+        this->_staticTCB = &tcb;
+    }
+
+    StaticTask(const StaticTask&) = delete;
+    StaticTask& operator=(const StaticTask&) = delete;
+
+    static constexpr size_t staticStackDepth = StackDepth;
+
+private:
+    StackType_t stack[StackDepth];
+    StaticTask_t tcb;
+};
+
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_STATICTASK_HPP
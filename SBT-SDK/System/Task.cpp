@@ -3,45 +3,181 @@
 //
 
 #include "Task.hpp"
+#include "CycleCounter.hpp"
 #include "FreeRTOS.h"
+#include "TaskManager.hpp"
 #include "task.h"
 
+#include <cstring>
+
 namespace SBT::System {
 
+Task::Task(const char* name, size_t priority, size_t stackDepth)
+    : _name{}, _priority(priority), _stackDepth(stackDepth)
+{
+    strncpy(_name, name, sizeof(_name) - 1);
+}
+
 Task::Task(const std::string& name, size_t priority, size_t stackDepth)
-    : _name(name), _priority(priority), _stackDepth(stackDepth)
+    : Task(name.c_str(), priority, stackDepth)
 {
 }
 
 void Task ::executeTask()
 {
+    checkIn();
     initialize();
+    TaskManager::taskInitialized();
 
     while(true) {
+        checkIn();
         run();
     }
 }
 
-const char* Task::getName() const { return _name.c_str(); }
+const char* Task::getName() const { return _name; }
 
 size_t Task::getPriority() const { return _priority; }
 
 size_t Task::getStackDepth() const { return _stackDepth; }
 
+PeriodicTask::PeriodicTask(const char* name, size_t priority,
+                           size_t periodicity, size_t stackDepth,
+                           OverrunPolicy overrunPolicy)
+    : Task(name, priority, stackDepth), _periodicity(periodicity),
+      _overrunPolicy(overrunPolicy)
+{
+}
+
 PeriodicTask::PeriodicTask(const std::string& name, size_t priority,
-                           size_t periodicity, size_t stackDepth)
-    : Task(name, priority, stackDepth), _periodicity(periodicity)
+                           size_t periodicity, size_t stackDepth,
+                           OverrunPolicy overrunPolicy)
+    : PeriodicTask(name.c_str(), priority, periodicity, stackDepth,
+                   overrunPolicy)
 {
 }
 
 void PeriodicTask::executeTask()
 {
+    checkIn();
     initialize();
+    TaskManager::taskInitialized();
+
+    Hardware::CycleCounter::Enable();
+
+    TickType_t lastRelease = xTaskGetTickCount();
+    uint32_t lastStart = 0;
+    bool firstRun = true;
 
     while(true) {
+        checkIn();
+        const uint32_t start = Hardware::CycleCounter::Get();
         run();
-        vTaskDelay(_periodicity);
+        const uint32_t executionCycles = Hardware::CycleCounter::Get() - start;
+
+        // Run ended after the next release time
+        const TickType_t elapsed = xTaskGetTickCount() - lastRelease;
+        const bool overrun = elapsed >= _periodicity;
+        uint32_t skipped = 0;
+        if(overrun && _overrunPolicy == OverrunPolicy::Skip) {
+            skipped = elapsed / _periodicity;
+            lastRelease += skipped * _periodicity;
+        }
+
+        updateStatistics(executionCycles, firstRun ? 0 : start - lastStart,
+                         overrun, skipped);
+        lastStart = start;
+        firstRun = false;
+
+        // Returns immediately if the next release time already passed
+        vTaskDelayUntil(&lastRelease, _periodicity);
     }
 }
 
+void PeriodicTask::updateStatistics(uint32_t executionCycles,
+                                    uint32_t startInterval, bool overrun,
+                                    uint32_t skipped)
+{
+    const uint32_t periodCycles =
+        _periodicity * (HAL_RCC_GetHCLKFreq() / configTICK_RATE_HZ);
+
+    taskENTER_CRITICAL();
+    _runs++;
+    if(overrun)
+        _overruns++;
+    _skippedReleases += skipped;
+
+    if(executionCycles < _executionMin)
+        _executionMin = executionCycles;
+    if(executionCycles > _executionMax)
+        _executionMax = executionCycles;
+    _executionSum += executionCycles;
+
+    // Interval of 0 marks the first run, without previous start
+    if(startInterval != 0) {
+        const uint32_t jitter = startInterval > periodCycles
+                                    ? startInterval - periodCycles
+                                    : periodCycles - startInterval;
+        if(jitter > _jitterMax)
+            _jitterMax = jitter;
+        _jitterSum += jitter;
+        _jitterSamples++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+Task::Timing PeriodicTask::getTiming() const
+{
+    return {static_cast<uint32_t>(_periodicity * 1000),
+            getStatistics().executionMaxUs};
+}
+
+PeriodicTask::Statistics PeriodicTask::getStatistics() const
+{
+    taskENTER_CRITICAL();
+    const uint32_t runs = _runs;
+    const uint32_t overruns = _overruns;
+    const uint32_t skippedReleases = _skippedReleases;
+    const uint32_t executionMin = _executionMin;
+    const uint32_t executionMax = _executionMax;
+    const uint64_t executionSum = _executionSum;
+    const uint32_t jitterMax = _jitterMax;
+    const uint64_t jitterSum = _jitterSum;
+    const uint32_t jitterSamples = _jitterSamples;
+    taskEXIT_CRITICAL();
+
+    using Hardware::CycleCounter;
+    Statistics stats{};
+    stats.runs = runs;
+    stats.overruns = overruns;
+    stats.skippedReleases = skippedReleases;
+    if(runs != 0) {
+        stats.executionMinUs = CycleCounter::ToMicroseconds(executionMin);
+        stats.executionMaxUs = CycleCounter::ToMicroseconds(executionMax);
+        stats.executionMeanUs =
+            CycleCounter::ToMicroseconds(executionSum / runs);
+    }
+    if(jitterSamples != 0) {
+        stats.jitterMaxUs = CycleCounter::ToMicroseconds(jitterMax);
+        stats.jitterMeanUs =
+            CycleCounter::ToMicroseconds(jitterSum / jitterSamples);
+    }
+    return stats;
+}
+
+void PeriodicTask::resetStatistics()
+{
+    taskENTER_CRITICAL();
+    _runs = 0;
+    _overruns = 0;
+    _skippedReleases = 0;
+    _executionMin = UINT32_MAX;
+    _executionMax = 0;
+    _executionSum = 0;
+    _jitterMax = 0;
+    _jitterSum = 0;
+    _jitterSamples = 0;
+    taskEXIT_CRITICAL();
+}
+
 } // namespace SBT::System
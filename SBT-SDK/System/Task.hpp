@@ -5,12 +5,29 @@
 #ifndef F1XX_PROJECT_TEMPLATE_TASK_HPP
 #define F1XX_PROJECT_TEMPLATE_TASK_HPP
 
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace SBT::System {
 
 class Task {
 public:
+    // Release period and the longest measured run(), see Schedulability.hpp
+    struct Timing {
+        // 0 if the task is not periodic
+        uint32_t periodUs;
+        // 0 if not measured yet
+        uint32_t executionMaxUs;
+    };
+
+    // Name is copied, so it does not have to outlive the constructor. Name
+    // longer than configMAX_TASK_NAME_LEN - 1 characters is truncated.
+    Task(const char* name, size_t priority, size_t stackDepth);
     Task(const std::string& name, size_t priority, size_t stackDepth);
 
     [[noreturn]] virtual void executeTask();
@@ -19,6 +36,34 @@ public:
     [[nodiscard]] size_t getPriority() const;
     [[nodiscard]] size_t getStackDepth() const;
 
+    // Memory reserved by StaticTask, nullptr if the task should be allocated
+    // from the FreeRTOS heap
+    [[nodiscard]] StackType_t* getStaticStack() const { return _staticStack; }
+    [[nodiscard]] StaticTask_t* getStaticTCB() const { return _staticTCB; }
+
+    // FreeRTOS handle, nullptr until TaskManager::startTasks() creates the task
+    [[nodiscard]] TaskHandle_t getHandle() const { return _handle; }
+
+    // Longest allowed time between check-ins in ms, 0 (default) if the task is
+    // not supervised, e.g. it blocks until an event which may never come. Such
+    // a task spinning instead of blocking is caught by the idle deadline. See
+    // TaskSupervisor.hpp. Has to be set before the task starts.
+    void setCheckInDeadline(uint32_t deadline) { _checkInDeadline = deadline; }
+    [[nodiscard]] uint32_t getCheckInDeadline() const
+    {
+        return _checkInDeadline;
+    }
+
+    // Report that the task is alive. Done before every run(), call it also
+    // from long loops inside run().
+    void checkIn() { _lastCheckIn.store(xTaskGetTickCount()); }
+    [[nodiscard]] TickType_t getLastCheckIn() const
+    {
+        return _lastCheckIn.load();
+    }
+
+    [[nodiscard]] virtual Timing getTiming() const { return {0, 0}; }
+
     // Setup method that is run single time at the start of the task
     virtual void initialize() = 0;
 
@@ -26,18 +71,64 @@ public:
     virtual void run() = 0;
 
 protected:
-    const std::string _name;
+    char _name[configMAX_TASK_NAME_LEN];
     const size_t _priority;
     const size_t _stackDepth;
+
+    StackType_t* _staticStack = nullptr;
+    StaticTask_t* _staticTCB = nullptr;
+
+private:
+    TaskHandle_t _handle = nullptr;
+
+    uint32_t _checkInDeadline = 0;
+    std::atomic<TickType_t> _lastCheckIn{0};
+
+    friend class TaskManager;
 };
 
+// Task released at fixed absolute times: n * '_periodicity' milliseconds after
+// the first release, regardless of execution time of run().
 class PeriodicTask : public Task {
 public:
+    // What to do when run() ends after the next release time
+    enum class OverrunPolicy {
+        // Drop missed releases and wait for the next release in the future
+        Skip,
+        // Run again immediately for every missed release
+        CatchUp
+    };
+
+    // Times are measured with the DWT cycle counter. Execution time includes
+    // preemption by higher priority tasks and interrupts. Jitter is the
+    // deviation of the time between two consecutive starts of run() from
+    // '_periodicity'.
+    struct Statistics {
+        uint32_t runs;
+        uint32_t overruns;
+        uint32_t skippedReleases;
+        uint32_t executionMinUs;
+        uint32_t executionMaxUs;
+        uint32_t executionMeanUs;
+        uint32_t jitterMaxUs;
+        uint32_t jitterMeanUs;
+    };
+
+    PeriodicTask(const char* name, size_t priority, size_t periodicity,
+                 size_t stackDepth,
+                 OverrunPolicy overrunPolicy = OverrunPolicy::Skip);
     PeriodicTask(const std::string& name, size_t priority, size_t periodicity,
-                 size_t stackDepth);
+                 size_t stackDepth,
+                 OverrunPolicy overrunPolicy = OverrunPolicy::Skip);
 
     [[noreturn]] void executeTask() override;
 
+    [[nodiscard]] Timing getTiming() const override;
+
+    // Safe to call from any task
+    [[nodiscard]] Statistics getStatistics() const;
+    void resetStatistics();
+
 protected:
     // Setup method that is run single time at the start of the task
     //  virtual void initialize() = 0;
@@ -47,6 +138,22 @@ protected:
 
 protected:
     const size_t _periodicity;
+    const OverrunPolicy _overrunPolicy;
+
+private:
+    void updateStatistics(uint32_t executionCycles, uint32_t startInterval,
+                          bool overrun, uint32_t skipped);
+
+    // Raw statistics in CPU cycles, guarded by critical section
+    uint32_t _runs = 0;
+    uint32_t _overruns = 0;
+    uint32_t _skippedReleases = 0;
+    uint32_t _executionMin = UINT32_MAX;
+    uint32_t _executionMax = 0;
+    uint64_t _executionSum = 0;
+    uint32_t _jitterMax = 0;
+    uint64_t _jitterSum = 0;
+    uint32_t _jitterSamples = 0;
 };
 
 } // namespace SBT::System
@@ -2,23 +2,38 @@
 #include "Error.hpp"
 
 #include <FreeRTOS.h>
-#include <queue.h>
+#include <task.h>
+
+#ifdef SBT_HEAP_FREEZE
+#include "Heap.hpp"
+#endif
 
 namespace SBT::System {
-std::vector<std::shared_ptr<Task>> TaskManager::_tasks;
+std::array<Task*, SBT_MAX_TASKS> TaskManager::_tasks{};
+size_t TaskManager::_taskCount = 0;
+size_t TaskManager::_initializedCount = 0;
+
+static void checkUserTaskPriority(const Task& task)
+{
+    if(task.getPriority() > 7)
+        // Only system tasks are allowed to have priority greater than 7
+        softfault({ErrorModule::TaskManager, ErrorCode::InvalidArgument,
+                   __LINE__, static_cast<uint32_t>(task.getPriority())});
+}
 
-void TaskManager::registerTask(const std::shared_ptr<Task>& task)
+void TaskManager::registerTask(Task& task)
 {
-    if(task->getPriority() > 7)
-        softfault(
-            __FILE__, __LINE__,
-            "Only system tasks are allowed to have priority greater than 7");
-    _tasks.push_back(task);
+    checkUserTaskPriority(task);
+    registerSystemTask(task);
 }
 
-void TaskManager::registerSystemTask(const std::shared_ptr<Task>& task)
+void TaskManager::registerSystemTask(Task& task)
 {
-    _tasks.push_back(task);
+    if(_taskCount >= _tasks.size())
+        // Increase SBT_MAX_TASKS
+        softfault({ErrorModule::TaskManager, ErrorCode::CapacityExceeded,
+                   __LINE__, SBT_MAX_TASKS});
+    _tasks[_taskCount++] = &task;
 }
 
 void TaskManager::startTasks()
@@ -30,16 +45,50 @@ void TaskManager::startTasks()
 
     // Create all task by calling executeTask(). This is done by passing task
     // pointer to taskEntryPoint.
-    for(const auto& task : _tasks) {
-        xTaskCreate(taskEntryPoint, task->getName(), task->getStackDepth(),
-                    task.get(), task->getPriority(), nullptr);
+    for(size_t i = 0; i < _taskCount; i++) {
+        Task* task = _tasks[i];
+        TaskHandle_t handle = nullptr;
+
+#if configSUPPORT_STATIC_ALLOCATION == 1
+        if(task->getStaticStack() != nullptr)
+            handle = xTaskCreateStatic(
+                taskEntryPoint, task->getName(), task->getStackDepth(), task,
+                task->getPriority(), task->getStaticStack(),
+                task->getStaticTCB());
+        else
+#endif
+            xTaskCreate(taskEntryPoint, task->getName(), task->getStackDepth(),
+                        task, task->getPriority(), &handle);
+
+        // Not enough heap for the task's stack, argument is its size
+        if(handle == nullptr)
+            softfault({ErrorModule::TaskManager, ErrorCode::CreateFailed,
+                       __LINE__,
+                       static_cast<uint32_t>(task->getStackDepth())});
+        task->_handle = handle;
     }
 }
 
+size_t TaskManager::getTaskCount() { return _taskCount; }
+
+Task& TaskManager::getTask(size_t index) { return *_tasks[index]; }
+
 void TaskManager::TasksInit()
 {
-    for(const auto& task : _tasks)
-        task->initialize();
+    for(size_t i = 0; i < _taskCount; i++)
+        _tasks[i]->initialize();
+}
+
+void TaskManager::taskInitialized()
+{
+    taskENTER_CRITICAL();
+    [[maybe_unused]] const bool last = ++_initializedCount == _taskCount;
+    taskEXIT_CRITICAL();
+
+#ifdef SBT_HEAP_FREEZE
+    if(last)
+        Heap::Freeze();
+#endif
 }
 
 // void TaskManager::startRtos() { vTaskStartScheduler(); }
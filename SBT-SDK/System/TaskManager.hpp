@@ -2,39 +2,56 @@
 #define TASKMANAGER_HPP
 
 #include <array>
-#include <memory>
-#include <vector>
 
 #include "Task.hpp"
 
+// Maximal number of tasks (system and user) registered in TaskManager
+#ifndef SBT_MAX_TASKS
+#define SBT_MAX_TASKS 12
+#endif
+
 // Abstract class that wraps user's tasks.
 // If user wants to create new task:
 // Create object derived from Task
 // Configure Task using Task's constructor
 // Implement initialize() and run()
-// Add this new task to TaskManager's tasks vector in registerTasks method
+// Register the task object, e.g. a static one, before System::Start()
 
 namespace SBT::System {
 class TaskManager {
 public:
-    // Register a task with priority constrained to be less than 8
-    static void registerTask(const std::shared_ptr<Task>& task);
+    // Register a task with priority constrained to be less than 8. Only a
+    // pointer is kept, the task has to live as long as the program, e.g. a
+    // static Task or StaticTask object. No memory is allocated.
+    static void registerTask(Task& task);
 
     // Register all tasks in FreeRTOS - allocate local stack etc.
     static void startTasks();
 
     // Calls "initialize()" function for all registered tasks
     static void TasksInit();
+
+    // Called by every task when its initialize() returned. With
+    // SBT_HEAP_FREEZE the last one freezes the heap.
+    static void taskInitialized();
+
+    // Registered tasks, index has to be less than getTaskCount()
+    static size_t getTaskCount();
+    static Task& getTask(size_t index);
     //
     //  // Start scheduler - this function theoretically should not return
     //  static void startRtos();
 
 private:
-    static std::vector<std::shared_ptr<Task>> _tasks;
+    // Fixed capacity, so registering tasks does not reallocate
+    static std::array<Task*, SBT_MAX_TASKS> _tasks;
+    static size_t _taskCount;
+    // Tasks which returned from initialize(), guarded by critical section
+    static size_t _initializedCount;
 
     // Register a task without priority constraints. Add a friend class or
     // function to use this method.
-    static void registerSystemTask(const std::shared_ptr<Task>& task);
+    static void registerSystemTask(Task& task);
 
     friend void Start(unsigned);
 };
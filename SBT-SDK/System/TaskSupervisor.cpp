@@ -0,0 +1,120 @@
+#include "TaskSupervisor.hpp"
+
+#include "task.h"
+
+#include "Hardware.hpp"
+#include "NoInit.hpp"
+#include "TaskManager.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace SBT::System {
+
+namespace {
+constexpr uint32_t recordMagic = 0x5B7A5C0D;
+
+// Written once, when the first deadline miss is detected
+struct Record {
+    uint32_t magic;
+    TaskSupervisor::Offender offender;
+};
+SBT_NOINIT Record record;
+
+IWDG_HandleTypeDef* watchdog = nullptr;
+bool started = false;
+
+// Record of the previous reset, copied by Initialize()
+TaskSupervisor::Offender lastOffender;
+bool hasLastOffender = false;
+
+// Set by the idle task, cleared by RefreshFromISR()
+std::atomic<bool> idleRan{false};
+
+// Touched only with interrupts masked
+bool tripped = false;
+uint32_t ticksSinceCheck = 0;
+// Ticks checked by the tick hook since the idle task last ran. Suppressed
+// ticks of tickless idle are not counted, the idle task runs them.
+uint32_t idleStarvedTicks = 0;
+
+void trip(const char* name, uint32_t elapsed)
+{
+    // Stop refreshing, the watchdog resets the node
+    strncpy(record.offender.name, name, sizeof(record.offender.name) - 1);
+    record.offender.name[sizeof(record.offender.name) - 1] = '\0';
+    record.offender.overdueMs = elapsed * 1000 / configTICK_RATE_HZ;
+    record.magic = recordMagic;
+    tripped = true;
+}
+} // namespace
+
+void TaskSupervisor::Initialize(IWDG_HandleTypeDef* _watchdog)
+{
+    // System::Init() has already read and cleared the RCC reset flags
+    if(record.magic == recordMagic &&
+       (Hardware::GetResetCause() & Hardware::ResetIndependentWatchdog)) {
+        lastOffender = record.offender;
+        lastOffender.name[sizeof(lastOffender.name) - 1] = '\0';
+        hasLastOffender = true;
+    }
+    record.magic = 0;
+
+    watchdog = _watchdog;
+    started = true;
+}
+
+void TaskSupervisor::RefreshFromISR()
+{
+    if(!started || tripped)
+        return;
+
+    if(idleRan.exchange(false))
+        idleStarvedTicks = 0;
+    else
+        idleStarvedTicks += SBT_SUPERVISOR_PERIOD;
+    if(SBT_SUPERVISOR_IDLE_DEADLINE != 0 &&
+       idleStarvedTicks >
+           SBT_SUPERVISOR_IDLE_DEADLINE * configTICK_RATE_HZ / 1000) {
+        trip("IDLE", idleStarvedTicks);
+        return;
+    }
+
+    const TickType_t now = xTaskGetTickCountFromISR();
+    for(size_t i = 0; i < TaskManager::getTaskCount(); i++) {
+        const Task& task = TaskManager::getTask(i);
+        const uint32_t deadline = task.getCheckInDeadline();
+        if(deadline == 0 || task.getHandle() == nullptr)
+            continue;
+
+        const TickType_t elapsed = now - task.getLastCheckIn();
+        if(elapsed <= deadline * configTICK_RATE_HZ / 1000)
+            continue;
+
+        trip(task.getName(), elapsed);
+        return;
+    }
+
+    if(watchdog != nullptr)
+        HAL_IWDG_Refresh(watchdog);
+}
+
+void TaskSupervisor::IdleCheckIn() { idleRan.store(true); }
+
+const TaskSupervisor::Offender* TaskSupervisor::GetLastOffender()
+{
+    return hasLastOffender ? &lastOffender : nullptr;
+}
+
+} // namespace SBT::System
+
+extern "C" {
+void vApplicationTickHook(void)
+{
+    using namespace SBT::System;
+    if(++ticksSinceCheck >= SBT_SUPERVISOR_PERIOD) {
+        ticksSinceCheck = 0;
+        TaskSupervisor::RefreshFromISR();
+    }
+}
+}
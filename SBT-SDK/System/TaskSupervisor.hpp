@@ -0,0 +1,72 @@
+#ifndef SBT_SYSTEM_TASKSUPERVISOR_HPP
+#define SBT_SYSTEM_TASKSUPERVISOR_HPP
+
+#include "FreeRTOS.h"
+
+#include <cstdint>
+#include <stm32f1xx_hal.h>
+
+// Time between checks of task check-ins, in ticks
+#ifndef SBT_SUPERVISOR_PERIOD
+#define SBT_SUPERVISOR_PERIOD 10
+#endif
+
+// Longest time the idle task may be starved, in ms, 0 to not supervise it
+#ifndef SBT_SUPERVISOR_IDLE_DEADLINE
+#define SBT_SUPERVISOR_IDLE_DEADLINE 1000
+#endif
+
+namespace SBT::System {
+/**
+ * @brief Watchdog supervision of tasks, enabled by SBT_TASK_SUPERVISOR.
+ * Instead of the idle hook, the tick hook refreshes the watchdog - and only
+ * while every supervised task has checked in within its deadline (see
+ * Task::setCheckInDeadline()). A livelocked or starved task lets the watchdog
+ * reset the node.
+ *
+ * The idle task is supervised too, with SBT_SUPERVISOR_IDLE_DEADLINE, so a
+ * task without a deadline which spins instead of blocking is still caught.
+ * The default of one second lets a burst of work, e.g. CAN traffic, starve
+ * the idle task for a while without resetting the node.
+ *
+ * Name of the first task which missed its deadline is kept in .noinit RAM
+ * (see NoInit.hpp) and is available after the watchdog reset.
+ */
+class TaskSupervisor {
+public:
+    struct Offender {
+        char name[configMAX_TASK_NAME_LEN];
+        // Time since the last check-in when the deadline miss was detected
+        uint32_t overdueMs;
+    };
+
+    TaskSupervisor() = delete;
+
+    /**
+     * @brief Read the record of the previous reset and start supervision. Has
+     * to be called before vTaskStartScheduler(), done by System::Start().
+     * @param watchdog started watchdog, nullptr if disabled
+     */
+    static void Initialize(IWDG_HandleTypeDef* watchdog);
+
+    /**
+     * @brief Check all supervised tasks and refresh the watchdog if none
+     * missed its deadline. Called from the tick hook and before tickless
+     * sleep, with interrupts masked.
+     */
+    static void RefreshFromISR();
+
+    /**
+     * @brief Report that the idle task is alive, called from the idle hook
+     */
+    static void IdleCheckIn();
+
+    /**
+     * @brief Task which caused the last watchdog reset
+     * @return nullptr if the last reset was not caused by a supervised task
+     */
+    [[nodiscard]] static const Offender* GetLastOffender();
+};
+} // namespace SBT::System
+
+#endif // SBT_SYSTEM_TASKSUPERVISOR_HPP
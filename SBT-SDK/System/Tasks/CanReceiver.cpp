@@ -2,66 +2,106 @@
 #include "CanReceiver.hpp"
 #include "CAN.hpp"
 #include "CommCAN.hpp"
-#include "Error.hpp"
+#include "CycleCounter.hpp"
+
+#ifdef SBT_TICKLESS_IDLE
+#include "LowPower.hpp"
+#endif
 
 using namespace SBT::Hardware;
 using namespace SBT::System::Comm;
 
 namespace SBT::System::Tasks {
 
-QueueHandle_t CanReceiver::xQueueHandle;
+TaskHandle_t CanReceiver::taskHandle = nullptr;
+RingBuffer<CAN::RxMessage, SBT_CAN_RECEIVER_QUEUE_SIZE> CanReceiver::queue;
 CAN::RxMessage CanReceiver::mess;
-uint8_t CanReceiver::failedMessCount = 0;
+uint32_t CanReceiver::failedMessCount = 0;
 
-#ifndef SBT_CAN_RECEIVER_STACK_SIZE
-#define SBT_CAN_RECEIVER_STACK_SIZE 256
-#endif
+std::atomic<uint32_t> CanReceiver::notifyCycles{0};
+uint32_t CanReceiver::wakeups = 0;
+uint32_t CanReceiver::wakeLatencyMax = 0;
+uint64_t CanReceiver::wakeLatencySum = 0;
 
-CanReceiver::CanReceiver()
-    : Task("CanReceiver", 15, SBT_CAN_RECEIVER_STACK_SIZE)
-{
-}
+CanReceiver::CanReceiver() : Task("CanReceiver", 15, StackDepth) {}
 
 void CanReceiver::initialize()
 {
-    // Create queue
-#ifndef SBT_CAN_RECEIVER_QUEUE_SIZE
-#define SBT_CAN_RECEIVER_QUEUE_SIZE 20
-#endif
-
-    xQueueHandle =
-        xQueueCreate(SBT_CAN_RECEIVER_QUEUE_SIZE, sizeof(CAN::RxMessage));
-
-    if(xQueueHandle == NULL)
-        softfault(__FILE__, __LINE__, "CanReceiver: Could not create xQueue");
+    CycleCounter::Enable();
+    taskHandle = xTaskGetCurrentTaskHandle();
 }
 
 void CanReceiver::run()
 {
-    // Get element from queue and send via Hardware CAN
-    xQueueReceive(xQueueHandle, &mess, portMAX_DELAY);
-
-    // Calculate our ID from raw extended CAN ID
-    mess.CalculateSBTid();
+    // Wait here until interrupt adds something to queue
+    while(!queue.Pop(mess)) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        const uint32_t notified = notifyCycles.exchange(0);
+        if(notified != 0) {
+            const uint32_t latency = CycleCounter::Get() - notified;
+            taskENTER_CRITICAL();
+            wakeups++;
+            wakeLatencySum += latency;
+            if(latency > wakeLatencyMax)
+                wakeLatencyMax = latency;
+            taskEXIT_CRITICAL();
+        }
+    }
+
+#ifdef SBT_TICKLESS_IDLE
+    LowPower::CanMessageHandled();
+#endif
 
     // Call proper user function
-    std::invoke(CAN::filters[mess.GetFilterBankID()], mess);
+    CAN::filters[mess.GetFilterBankID()](mess);
+}
+
+CanReceiver::Statistics CanReceiver::GetStatistics()
+{
+    taskENTER_CRITICAL();
+    const uint32_t count = wakeups;
+    const uint32_t max = wakeLatencyMax;
+    const uint64_t sum = wakeLatencySum;
+    taskEXIT_CRITICAL();
+
+    return {count, CycleCounter::ToMicroseconds(max),
+            count == 0 ? 0
+                       : CycleCounter::ToMicroseconds(
+                             static_cast<uint32_t>(sum / count))};
 }
 
 void CanReceiver::AddToQueue(CAN::RxMessage _mess)
 {
-    // 1 Tick here means 1ms
-    if(xQueueSend(xQueueHandle, &_mess, static_cast<TickType_t>(100)) != pdTRUE)
+    // Queue has a single producer - the interrupt - so it is masked here
+    taskENTER_CRITICAL();
+    const bool added = queue.Push(_mess);
+    taskEXIT_CRITICAL();
+
+    if(!added)
         failedMessCount++;
+    else if(taskHandle != nullptr)
+        xTaskNotifyGive(taskHandle);
 }
 
 void CanReceiver::AddToQueueFromISR(CAN::RxMessage _mess)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    if(xQueueSendFromISR(xQueueHandle, &_mess, &xHigherPriorityTaskWoken) !=
-       pdTRUE)
+    // RX FIFO interrupts have the same priority and do not preempt each
+    // other, so they are a single producer
+    const bool wasEmpty = queue.IsEmpty();
+    if(!queue.Push(_mess)) {
         failedMessCount++;
+        return;
+    }
+
+    if(taskHandle != nullptr) {
+        // Task waits only for the first message in empty queue
+        if(wasEmpty)
+            notifyCycles.store(CycleCounter::Get());
+        vTaskNotifyGiveFromISR(taskHandle, &xHigherPriorityTaskWoken);
+    }
 
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
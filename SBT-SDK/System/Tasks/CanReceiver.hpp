@@ -2,35 +2,73 @@
 #define CANRECEIVER_HPP
 
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "task.h"
 
 #include "CommCAN.hpp"
+#include "RingBuffer.hpp"
 #include "TaskManager.hpp"
+
+#include <atomic>
+
+#ifndef SBT_CAN_RECEIVER_QUEUE_SIZE
+#define SBT_CAN_RECEIVER_QUEUE_SIZE 20
+#endif
+
 /**
- * @brief This task checks if there is new message in receivedMessageQueue. If
- * there is new value it checks from which filter bank is this mess and calls
+ * @brief This task checks if there is new message in received messages queue.
+ * If there is new value it checks from which filter bank is this mess and calls
  * proper user callback. Adding to queue is happening in interrupt so there
  * isn't any timeout for that, if queue is full we lost this message. But if the
  * message is lost we increment failedMessCount variable and Heartbeat is
  * accessing this data and send them in heartbeat frame. It has almost the
- * highest priority. Queue size is 20. To call proper user function we use map
- * from System::Comm:CAN driver. Similarly as CanSender if queue is empty task
- * is getting into hibernation mode and blocks action until something is added.
+ * highest priority. Queue size is 20. To call proper user function we use
+ * filters array from System::Comm:CAN driver. Queue is a lock-free ring buffer
+ * filled by RX interrupt, if it is empty task is blocked on a task notification
+ * until the interrupt adds something.
  */
 namespace SBT::System::Tasks {
 
+#ifndef SBT_CAN_RECEIVER_STACK_SIZE
+#define SBT_CAN_RECEIVER_STACK_SIZE 256
+#endif
+
 struct CanReceiver : public SBT::System::Task {
+    static constexpr size_t StackDepth = SBT_CAN_RECEIVER_STACK_SIZE;
+
+    // Time from RX interrupt notifying an empty queue to the task running,
+    // measured with the DWT cycle counter
+    struct Statistics {
+        uint32_t wakeups;
+        uint32_t wakeLatencyMaxUs;
+        uint32_t wakeLatencyMeanUs;
+    };
+
     CanReceiver();
     void initialize() override;
     void run() override;
 
-    static QueueHandle_t xQueueHandle;
+    static TaskHandle_t taskHandle;
+    static RingBuffer<SBT::System::Comm::CAN::RxMessage,
+                      SBT_CAN_RECEIVER_QUEUE_SIZE>
+        queue;
     static SBT::System::Comm::CAN::RxMessage mess;
 
-    static uint8_t failedMessCount;
+    static uint32_t failedMessCount;
+
+    // Cycle counter value when interrupt woke the task, 0 if not pending
+    static std::atomic<uint32_t> notifyCycles;
+    static uint32_t wakeups;
+    static uint32_t wakeLatencyMax;
+    static uint64_t wakeLatencySum;
 
 public:
-    static uint8_t GetFailedMessCount() { return failedMessCount; }
+    // Wraps at 2^32, compare readings by unsigned subtraction
+    static uint32_t GetFailedMessCount() { return failedMessCount; }
+
+    // Highest number of messages waiting in queue since reset
+    static size_t GetQueueHighWaterMark() { return queue.GetHighWaterMark(); }
+
+    static Statistics GetStatistics();
 
     static void AddToQueue(SBT::System::Comm::CAN::RxMessage _mess);
     static void AddToQueueFromISR(SBT::System::Comm::CAN::RxMessage _mess);
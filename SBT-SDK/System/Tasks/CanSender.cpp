@@ -2,76 +2,95 @@
 #include "CanSender.hpp"
 #include "CAN.hpp"
 #include "CommCAN.hpp"
-#include "Error.hpp"
 
 using namespace SBT::Hardware;
 using namespace SBT::System::Comm;
 
 namespace SBT::System::Tasks {
 
-QueueHandle_t CanSender::xQueueHandle;
-SemaphoreHandle_t CanSender::xSemaphore;
-uint8_t CanSender::failedMessCount = 0;
+TaskHandle_t CanSender::taskHandle = nullptr;
+RingBuffer<CAN::TxMessage, SBT_CAN_SENDER_QUEUE_SIZE> CanSender::queue;
+uint32_t CanSender::failedMessCount = 0;
 
-// min. stackDepth = 61 (with my setup ~ @DarKreter)
-CanSender::CanSender() : Task("CanSender", 12, 72) {}
+// Longest wait for a free TX mailbox, 1 Tick here means 1ms
+static constexpr TickType_t mailboxTimeout = 100;
 
-void CanSender::initialize()
-{
-    // Create queue
-#ifndef SBT_CAN_SENDER_QUEUE_SIZE
-#define SBT_CAN_SENDER_QUEUE_SIZE 20
-#endif
-
-    xQueueHandle =
-        xQueueCreate(SBT_CAN_SENDER_QUEUE_SIZE, sizeof(CAN::TxMessage));
-
-    if(xQueueHandle == NULL)
-        softfault(__FILE__, __LINE__, "CanSender: Could not create xQueue");
+CanSender::CanSender() : Task("CanSender", 12, StackDepth) {}
 
-    xSemaphore = xSemaphoreCreateCounting(3, 3);
-    if(xSemaphore == NULL)
-        softfault(__FILE__, __LINE__, "CanSender: Could not create xSemaphore");
-}
+void CanSender::initialize() { taskHandle = xTaskGetCurrentTaskHandle(); }
 
 void CanSender::run()
 {
     // Get element from queue and send via Hardware CAN
     // Wait here until something is in queue
-    xQueueReceive(xQueueHandle, &mess, portMAX_DELAY);
-
-    if(xSemaphoreTake(xSemaphore, static_cast<TickType_t>(100)) == pdTRUE) {
-        if(SBT::Hardware::can.Send(mess.GetExtID(), mess.GetPayload()) !=
-           HAL_OK)
+    while(!queue.Pop(mess))
+        ulTaskNotifyTakeIndexed(queueNotification, pdTRUE, portMAX_DELAY);
+
+    // Free mailboxes are read from the hardware. Automatic retransmission is
+    // off, so a mailbox is also freed by lost arbitration or a transmit error,
+    // which end in the error callback instead of TX complete; counting
+    // completions would lose those mailboxes for good. The notification only
+    // wakes the task, a stale one costs one more check.
+    const TickType_t start = xTaskGetTickCount();
+    while(!SBT::Hardware::can.IsAnyTxMailboxFree()) {
+        const TickType_t waited = xTaskGetTickCount() - start;
+        if(waited >= mailboxTimeout) {
             failedMessCount++;
+            return;
+        }
+        ulTaskNotifyTakeIndexed(mailboxNotification, pdTRUE,
+                                mailboxTimeout - waited);
     }
-    else {
+
+    if(SBT::Hardware::can.Send(mess.GetExtID(), mess.GetPayload()) != HAL_OK)
         failedMessCount++;
-        xSemaphoreGive(xSemaphore);
-    }
 }
 
 void CanSender::CanTxCompleteCallback()
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xSemaphoreGiveFromISR(xSemaphore, &xHigherPriorityTaskWoken);
+    vTaskNotifyGiveIndexedFromISR(taskHandle, mailboxNotification,
+                                  &xHigherPriorityTaskWoken);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 void CanSender::AddToQueue(CAN::TxMessage _mess)
 {
-    // 1 Tick here means 1ms
-    if(xQueueSend(xQueueHandle, &_mess, static_cast<TickType_t>(100)) != pdTRUE)
-        failedMessCount++;
+    // Any task may add messages, so pushing is serialised. If queue is full
+    // retry for 100 ticks, 1 Tick here means 1ms
+    for(uint32_t retry = 0;; retry++) {
+        taskENTER_CRITICAL();
+        const bool added = queue.Push(_mess);
+        taskEXIT_CRITICAL();
+
+        if(added)
+            break;
+        if(retry == 100) {
+            failedMessCount++;
+            return;
+        }
+        vTaskDelay(1);
+    }
+
+    // Task is not created yet, it will find the message in queue when it
+    // starts
+    if(taskHandle != nullptr)
+        xTaskNotifyGiveIndexed(taskHandle, queueNotification);
 }
 
 void CanSender::AddToQueueFromISR(CAN::TxMessage _mess)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-    if(xQueueSendFromISR(xQueueHandle, &_mess, &xHigherPriorityTaskWoken) !=
-       pdTRUE)
+    const UBaseType_t savedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    const bool added = queue.Push(_mess);
+    taskEXIT_CRITICAL_FROM_ISR(savedInterruptStatus);
+
+    if(!added)
         failedMessCount++;
+    else if(taskHandle != nullptr)
+        vTaskNotifyGiveIndexedFromISR(taskHandle, queueNotification,
+                                      &xHigherPriorityTaskWoken);
 
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
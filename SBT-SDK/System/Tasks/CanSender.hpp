@@ -2,42 +2,60 @@
 #define CANSENDER_HPP
 
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "task.h"
 
 #include "CommCAN.hpp"
+#include "RingBuffer.hpp"
 #include "TaskManager.hpp"
-#include "semphr.h"
+
+#ifndef SBT_CAN_SENDER_QUEUE_SIZE
+#define SBT_CAN_SENDER_QUEUE_SIZE 20
+#endif
 
 namespace SBT::System::Tasks {
 /**
  * @brief This task has one purpose:
  * check if there is new value in queue, which contains transmitting messages
  * and if there is something it transmit it directly to the CAN bus
- * Task is running without any periodicity but getting from queue is based on
- * semaphore. That means if queue is empty task is getting into hibernation mode
- * until something is added. Queue size is 20 elements. Adding to queue is
- * timeouted to 100ms. If this process takes longer time than 100ms message will
- * not be added to queue. (After 100ms there is definitely bigger problem than
- * just full queue). But if the message is lost we increment failedMessCount
- * variable and Heartbeat is accessing this data and send them in heartbeat
- * frame.
+ * Task is running without any periodicity. If queue is empty task is blocked
+ * on a task notification until something is added. If all TX mailboxes are
+ * busy it waits on another notification of the task, given when a mailbox
+ * completes, is aborted or fails (error interrupt), for at most 100ms. Queue
+ * size is 20 elements. If queue is full adding is retried for 100ms. If this
+ * process takes longer time than 100ms message will not be added to queue.
+ * (After 100ms there is definitely bigger problem than just full queue). But
+ * if the message is lost we increment failedMessCount variable and Heartbeat
+ * is accessing this data and send them in heartbeat frame.
  */
 
 struct CanSender : public SBT::System::Task {
+    // min. stackDepth = 61 (with my setup ~ @DarKreter)
+    static constexpr size_t StackDepth = 72;
+
+    // Indexes in notification array of the task
+    static constexpr UBaseType_t queueNotification = 0;
+    static constexpr UBaseType_t mailboxNotification = 1;
+
     CanSender();
     void initialize() override;
     void run() override;
 
-    static QueueHandle_t xQueueHandle;
+    static TaskHandle_t taskHandle;
+    static RingBuffer<SBT::System::Comm::CAN::TxMessage,
+                      SBT_CAN_SENDER_QUEUE_SIZE>
+        queue;
     SBT::System::Comm::CAN::TxMessage mess;
 
-    static SemaphoreHandle_t xSemaphore;
-
-    static uint8_t failedMessCount;
+    static uint32_t failedMessCount;
 
 public:
-    static uint8_t GetFailedMessCount() { return failedMessCount; }
+    // Wraps at 2^32, compare readings by unsigned subtraction
+    static uint32_t GetFailedMessCount() { return failedMessCount; }
+
+    // Highest number of messages waiting in queue since reset
+    static size_t GetQueueHighWaterMark() { return queue.GetHighWaterMark(); }
 
+    // Called by TX complete, TX abort and CAN error interrupts
     static void CanTxCompleteCallback();
 
     static void AddToQueue(SBT::System::Comm::CAN::TxMessage _mess);
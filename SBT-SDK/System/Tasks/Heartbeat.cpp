@@ -9,12 +9,32 @@
 #include "CanReceiver.hpp"
 #endif
 
+#include "CAN.hpp"
 #include "CommCAN.hpp"
+#include "ErrorLog.hpp"
+#include "Hardware.hpp"
+#include "Heap.hpp"
 #endif
 
 #include "GPIO.hpp"
 #include "Time.hpp"
 
+#ifdef SBT_RUNTIME_STATS
+#include "RuntimeStats.hpp"
+#endif
+#ifdef SBT_STACK_MONITOR
+#include "StackMonitor.hpp"
+#endif
+#ifdef SBT_CRASH_DUMP
+#include "CrashDump.hpp"
+#endif
+#ifdef SBT_TIME_SYNC
+#include "TimeSync.hpp"
+#endif
+#ifdef SBT_CAN_TRANSMIT_POLICY
+#include "CanTransmitPolicy.hpp"
+#endif
+
 namespace SBT::System::Tasks {
 
 using namespace SBT::Hardware;
@@ -24,8 +44,14 @@ using namespace SBT::System;
 using namespace SBT::System::Comm;
 #endif
 
-// min. stackDepth = 73 (with my setup ~ @DarKreter)
-Heartbeat::Heartbeat() : PeriodicTask("Heartbeat", 9, 1000, 85) {}
+#ifdef SBT_JOB_SCHEDULER
+Heartbeat::Heartbeat() : Job("Heartbeat", 0, 1000) {}
+#else
+Heartbeat::Heartbeat() : PeriodicTask("Heartbeat", 9, 1000, StackDepth)
+{
+    setCheckInDeadline(3 * _periodicity);
+}
+#endif
 
 void Heartbeat::initialize()
 {
@@ -34,22 +60,117 @@ void Heartbeat::initialize()
 
 void Heartbeat::run()
 {
+#ifdef SBT_RUNTIME_STATS
+    RuntimeStats::Update();
+#endif
+#ifdef SBT_STACK_MONITOR
+    StackMonitor::Sample();
+#endif
+
 #ifndef SBT_CAN_DISABLE
 #ifndef SBT_CAN_SENDER_DISABLE
     // Create payload for can send
     data.upTime = Time::GetUpTime();
 
+    // Lowest 8 bits, full counters are on HEARTBEAT_EXT pages
 #ifndef SBT_CAN_RECEIVER_DISABLE
-    data.canRxMessFailCount = CanReceiver::GetFailedMessCount();
+    data.canRxMessFailCount =
+        static_cast<uint8_t>(CanReceiver::GetFailedMessCount());
 #else
     data.canRxMessFailCount = 0;
 #endif
 
-    data.canTxMessFailCount = CanSender::GetFailedMessCount();
+    data.canTxMessFailCount =
+        static_cast<uint8_t>(CanSender::GetFailedMessCount());
     Pack_HEARTBEAT(&data, payload);
 
     // Send heartbeat
     CAN::Send(CAN_ID::Message::HEARTBEAT, payload);
+
+    // Report one logged error per run, errors from before the last reset
+    // are sent first
+    Error error{};
+    if(ErrorLog::PopUnreported(error)) {
+        errorLog.module = static_cast<uint8_t>(error.module);
+        errorLog.code = static_cast<uint8_t>(error.code);
+        errorLog.line = error.line;
+        errorLog.argument = error.argument;
+        Pack_ERROR_LOG(&errorLog, payload);
+
+        CAN::Send(CAN_ID::Message::ERROR_LOG, payload);
+    }
+
+    fillPage();
+    Pack_HEARTBEAT_EXT(&extended, payload);
+    CAN::Send(CAN_ID::Message::HEARTBEAT_EXT, payload);
+    page = (page + 1) % static_cast<uint8_t>(Page::Count);
+
+#ifdef SBT_CRASH_DUMP
+    // Stream the record of the last crash, a part in every run
+    if(CrashDump::GetLastCrash() != nullptr) {
+        for(size_t i = 0; i < SBT_CRASH_DUMP_FRAMES &&
+                          crashDumpIndex < CrashDump::RecordWords;
+            i++, crashDumpIndex++) {
+            crashDump.index = crashDumpIndex;
+            crashDump.count = CrashDump::RecordWords;
+            crashDump.value = CrashDump::GetLastCrashWord(crashDumpIndex);
+            Pack_CRASH_DUMP(&crashDump, payload);
+
+            CAN::Send(CAN_ID::Message::CRASH_DUMP, payload);
+        }
+    }
+#endif
+
+#ifdef SBT_COUNTERS
+    // Stream one snapshot over several runs, so values of a snapshot are
+    // consistent with each other
+    if(counterIndex == counterCount) {
+        counterCount = Counters::Snapshot(counterValues, SBT_MAX_COUNTERS);
+        counterIndex = 0;
+    }
+    for(size_t i = 0; i < SBT_COUNTER_FRAMES && counterIndex < counterCount;
+        i++, counterIndex++) {
+        counter.index = counterIndex;
+        counter.count = counterCount;
+        counter.id = Counters::Get(counterIndex)->GetId();
+        counter.value = counterValues[counterIndex];
+        Pack_COUNTER(&counter, payload);
+
+        CAN::Send(CAN_ID::Message::COUNTER, payload);
+    }
+#endif
+
+#ifdef SBT_TIME_SYNC
+#ifdef SBT_TIME_SYNC_MASTER
+    TimeSync::SendSync();
+#endif
+    const TimeSync::Status sync = TimeSync::GetStatus();
+    timeSyncStatus.state = static_cast<uint8_t>(sync.state);
+    timeSyncStatus.master = static_cast<uint8_t>(sync.master);
+    // In hundredths of ppm
+    timeSyncStatus.drift = static_cast<int16_t>(sync.drift / 10);
+    timeSyncStatus.error = sync.offsetError;
+    Pack_TIME_SYNC_STATUS(&timeSyncStatus, payload);
+
+    CAN::Send(CAN_ID::Message::TIME_SYNC_STATUS, payload);
+#endif
+
+#ifdef SBT_RUNTIME_STATS
+    RuntimeStats::TaskLoad top[3]{};
+    RuntimeStats::GetTopConsumers(top, 3);
+
+    cpuLoad.idleLoad = RuntimeStats::GetIdleLoad();
+    cpuLoad.taskCount = RuntimeStats::GetTaskCount();
+    cpuLoad.task1Number = top[0].number;
+    cpuLoad.task1Load = top[0].load;
+    cpuLoad.task2Number = top[1].number;
+    cpuLoad.task2Load = top[1].load;
+    cpuLoad.task3Number = top[2].number;
+    cpuLoad.task3Load = top[2].load;
+    Pack_CPU_LOAD(&cpuLoad, payload);
+
+    CAN::Send(CAN_ID::Message::CPU_LOAD, payload);
+#endif
 #endif
 #endif
 
@@ -57,4 +178,83 @@ void Heartbeat::run()
     GPIO::Toggle(GPIOC, GPIO_PIN_13);
 }
 
+#ifndef SBT_CAN_DISABLE
+void Heartbeat::fillPage()
+{
+    constexpr uint8_t none8 = UINT8_MAX;
+    constexpr uint16_t none16 = UINT16_MAX;
+    constexpr uint32_t none32 = UINT32_MAX;
+
+    extended.page = page;
+    extended.value8 = none8;
+    extended.value16 = none16;
+    extended.value32 = none32;
+
+    switch(static_cast<Page>(page)) {
+    case Page::LoadHeap: {
+#ifdef SBT_RUNTIME_STATS
+        extended.value8 = RuntimeStats::GetIdleLoad();
+#endif
+        const Heap::Statistics heap = Heap::GetStatistics();
+        extended.value16 = static_cast<uint16_t>(heap.size - heap.peakUsed);
+        extended.value32 = heap.size - heap.used;
+        break;
+    }
+    case Page::Stack: {
+#ifdef SBT_STACK_MONITOR
+        const StackMonitor::Entry stack = StackMonitor::GetWorstStack();
+        if(stack.size != 0) {
+            extended.value8 =
+                static_cast<uint8_t>(stack.used * 100U / stack.size);
+            extended.value16 = static_cast<uint16_t>(stack.size - stack.used);
+        }
+#endif
+        extended.value32 = ErrorLog::GetCount();
+        break;
+    }
+    case Page::CanSender:
+#ifndef SBT_CAN_SENDER_DISABLE
+        extended.value8 =
+            static_cast<uint8_t>(CanSender::GetQueueHighWaterMark());
+        extended.value16 = SBT_CAN_SENDER_QUEUE_SIZE;
+        extended.value32 = CanSender::GetFailedMessCount();
+#endif
+        break;
+    case Page::CanReceiver:
+#ifndef SBT_CAN_RECEIVER_DISABLE
+        extended.value8 =
+            static_cast<uint8_t>(CanReceiver::GetQueueHighWaterMark());
+        extended.value16 = SBT_CAN_RECEIVER_QUEUE_SIZE;
+        extended.value32 = CanReceiver::GetFailedMessCount();
+#endif
+        break;
+    case Page::CanBus: {
+        const hCAN::ErrorCounters errors = can.GetErrorCounters();
+        extended.value8 = errors.transmitErrors;
+        extended.value16 = errors.receiveErrors;
+        extended.value32 = errors.busOffCount;
+        break;
+    }
+    case Page::ResetHeap: {
+        const Heap::Statistics heap = Heap::GetStatistics();
+        extended.value8 = GetResetCause();
+        extended.value16 = static_cast<uint16_t>(heap.largestFreeBlock);
+        extended.value32 = heap.allocations;
+        break;
+    }
+    case Page::TransmitPolicy: {
+#ifdef SBT_CAN_TRANSMIT_POLICY
+        const TransmitPolicyBase::Statistics policy =
+            TransmitPolicyBase::GetTotalStatistics();
+        extended.value8 = policy.GetReductionPercent();
+        extended.value32 = policy.suppressed;
+#endif
+        break;
+    }
+    case Page::Count:
+        break;
+    }
+}
+#endif
+
 } // namespace SBT::System::Tasks
\ No newline at end of file
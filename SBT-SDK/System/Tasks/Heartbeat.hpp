@@ -5,15 +5,72 @@
 #include "CanParser_autogenerated.hpp"
 #endif
 
+#ifdef SBT_COUNTERS
+#include "Counters.hpp"
+#endif
+
+#ifdef SBT_JOB_SCHEDULER
+#include "JobScheduler.hpp"
+#else
 #include "TaskManager.hpp"
+#endif
 /**
  * @brief Task meant for blinking builtin led and sending heartbeat info to the
  * CAN bus. It works with 1s periodicity. In heartbeat info we have up time,
  * count of failed TxMessages to CAN and count of failed RxMessages to CAN.
+ * Errors from ErrorLog which were not reported yet are sent as ERROR_LOG, one
+ * per period. With SBT_CRASH_DUMP the record of the last crash is streamed as
+ * CRASH_DUMP, SBT_CRASH_DUMP_FRAMES words per period. With SBT_COUNTERS a
+ * snapshot of all counters is streamed as COUNTER, SBT_COUNTER_FRAMES counters
+ * per period; a new snapshot is taken when the previous one has been sent.
+ * With SBT_TIME_SYNC it sends TIME_SYNC_STATUS, on the master
+ * (SBT_TIME_SYNC_MASTER) also TIME_SYNC, so clocks are synchronised once per
+ * period.
+ * With SBT_RUNTIME_STATS it also sends CPU_LOAD - idle load and three tasks
+ * with the highest load during the last second.
+ * Diagnostics are sent as HEARTBEAT_EXT, one Page per period in turn, so they
+ * add one frame per second to the bus load. Counters are 32-bit and wrap, so
+ * compare two readings by unsigned subtraction. Values which are not measured
+ * in the current configuration are sent as all ones.
+ * With SBT_JOB_SCHEDULER it is a job of the system JobScheduler instead of a
+ * task with its own stack. Its check-in deadline (see TaskSupervisor.hpp) is
+ * three periods.
  */
 namespace SBT::System::Tasks {
 
+#ifdef SBT_JOB_SCHEDULER
+struct Heartbeat : public SBT::System::Job {
+#else
 struct Heartbeat : public SBT::System::PeriodicTask {
+    // min. stackDepth = 73 (with my setup ~ @DarKreter)
+#ifdef SBT_RUNTIME_STATS
+    static constexpr size_t StackDepth = 116;
+#else
+    static constexpr size_t StackDepth = 101;
+#endif
+#endif
+
+    // Page of HEARTBEAT_EXT, meaning of value8, value16 and value32
+    enum class Page : uint8_t {
+        // Idle CPU in percent, minimum ever free heap, free heap (bytes)
+        LoadHeap,
+        // Worst stack usage in percent, its unused words, errors logged
+        Stack,
+        // CanSender queue high-water mark, queue size, failed messages
+        CanSender,
+        // CanReceiver queue high-water mark, queue size, failed messages
+        CanReceiver,
+        // CAN transmit error counter, receive error counter, bus-off entries
+        CanBus,
+        // Hardware::ResetCause flags, largest free heap block (bytes), heap
+        // allocations
+        ResetHeap,
+        // Frames suppressed by CAN transmit policies in percent of frames
+        // offered, unused, suppressed frames
+        TransmitPolicy,
+        Count
+    };
+
     Heartbeat();
     void initialize() override;
     void run() override;
@@ -21,6 +78,28 @@ struct Heartbeat : public SBT::System::PeriodicTask {
 #ifndef SBT_CAN_DISABLE
     uint8_t payload[8]{};
     SBT::System::Comm::HEARTBEAT_t data;
+    SBT::System::Comm::ERROR_LOG_t errorLog;
+    SBT::System::Comm::HEARTBEAT_EXT_t extended;
+    uint8_t page = 0;
+
+    // Fill extended with the values of page
+    void fillPage();
+#ifdef SBT_CRASH_DUMP
+    SBT::System::Comm::CRASH_DUMP_t crashDump;
+    size_t crashDumpIndex = 0;
+#endif
+#ifdef SBT_COUNTERS
+    SBT::System::Comm::COUNTER_t counter;
+    uint32_t counterValues[SBT_MAX_COUNTERS]{};
+    size_t counterCount = 0;
+    size_t counterIndex = 0;
+#endif
+#ifdef SBT_TIME_SYNC
+    SBT::System::Comm::TIME_SYNC_STATUS_t timeSyncStatus;
+#endif
+#ifdef SBT_RUNTIME_STATS
+    SBT::System::Comm::CPU_LOAD_t cpuLoad;
+#endif
 #endif
 };
 
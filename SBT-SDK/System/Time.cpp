@@ -0,0 +1,31 @@
+#include "Time.hpp"
+
+#include "CycleCounter.hpp"
+
+namespace SBT::System::Time {
+
+namespace {
+// Guarded by masked interrupts. Upper half of the count and the last value
+// read from the cycle counter.
+uint32_t wraps = 0;
+uint32_t lastCycles = 0;
+} // namespace
+
+void Initialize() { Hardware::CycleCounter::Enable(); }
+
+uint64_t GetCycles()
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    const uint32_t cycles = Hardware::CycleCounter::Get();
+    if(cycles < lastCycles)
+        wraps++;
+    lastCycles = cycles;
+    const uint64_t total = (static_cast<uint64_t>(wraps) << 32) | cycles;
+
+    __set_PRIMASK(primask);
+    return total;
+}
+
+} // namespace SBT::System::Time
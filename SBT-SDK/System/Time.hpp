@@ -4,8 +4,81 @@
 #include <cstdint>
 #include <stm32f1xx_hal.h>
 
+/**
+ * @brief Time since reset. GetUpTime() is the HAL tick in milliseconds, it
+ * wraps after 49 days.
+ *
+ * GetCycles() is a 64-bit monotonic count of core clock cycles - 1/72 us at
+ * 72 MHz - which does not wrap during the life of the device. It extends the
+ * 32-bit DWT cycle counter: every read compares the counter with the previous
+ * one and counts a wrap when it is lower. The SysTick handler reads it on
+ * every tick, so no wrap (~59 s at 72 MHz) is missed. A read masks interrupts
+ * for a few instructions, so it is safe in tasks and interrupts of any
+ * priority.
+ *
+ * With SBT_TICKLESS_IDLE the cycle counter stops while the core sleeps.
+ * LowPower measures each sleep with SysTick, which keeps running, and advances
+ * the counter by the cycles it missed, so GetCycles() keeps counting real
+ * time across sleeps.
+ *
+ * Conversions use the current HCLK, so they are exact only for intervals
+ * measured without changing the clock.
+ *
+ * @example
+ *   const uint64_t start = Time::GetCycles();
+ *   work();
+ *   const uint32_t took = Time::ElapsedMicroseconds(start);
+ */
 namespace SBT::System::Time {
 inline uint32_t GetUpTime() { return HAL_GetTick(); }
+
+/**
+ * @brief Enable the cycle counter, done by System::Init()
+ */
+void Initialize();
+
+// Core clock cycles since Initialize()
+[[nodiscard]] uint64_t GetCycles();
+
+[[nodiscard]] inline uint32_t CyclesPerMicrosecond()
+{
+    return HAL_RCC_GetHCLKFreq() / 1'000'000;
+}
+
+[[nodiscard]] inline uint64_t ToMicroseconds(uint64_t cycles)
+{
+    // 64-bit division is a library call on Cortex-M3, avoid it when possible
+    if(cycles <= UINT32_MAX)
+        return static_cast<uint32_t>(cycles) / CyclesPerMicrosecond();
+    return cycles / CyclesPerMicrosecond();
+}
+
+[[nodiscard]] inline uint64_t ToCycles(uint64_t microseconds)
+{
+    return microseconds * CyclesPerMicrosecond();
+}
+
+[[nodiscard]] inline uint64_t GetMicroseconds()
+{
+    return ToMicroseconds(GetCycles());
+}
+
+// Cycles since an earlier GetCycles()
+[[nodiscard]] inline uint64_t ElapsedCycles(uint64_t since)
+{
+    return GetCycles() - since;
+}
+
+/**
+ * @brief Microseconds since an earlier GetCycles(), saturated at UINT32_MAX
+ * (71 minutes)
+ */
+[[nodiscard]] inline uint32_t ElapsedMicroseconds(uint64_t since)
+{
+    const uint64_t microseconds = ToMicroseconds(ElapsedCycles(since));
+    return microseconds < UINT32_MAX ? static_cast<uint32_t>(microseconds)
+                                     : UINT32_MAX;
+}
 } // namespace SBT::System::Time
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Print code size of CAN Pack_* / Unpack_* functions and ID codec helpers as
+# JSON lines, one per function:
+# {"function":"Unpack_HEARTBEAT","size":52}
+#
+# Usage: codesize.sh FILE [NM]
+#   FILE  firmware ELF or object file (e.g. CanParser_autogenerated.cpp.obj)
+#   NM    nm executable, default: arm-none-eabi-nm
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 FILE [NM]" >&2
+    exit 1
+fi
+
+NM=${2:-arm-none-eabi-nm}
+
+"$NM" --print-size --size-sort --radix=d --demangle "$1" |
+    awk '$3 ~ /^[tTwW]$/ {
+        name = $4
+        for(i = 5; i <= NF; i++)
+            name = name " " $i
+        sub(/\(.*$/, "", name)
+        sub(/^SBT::System::Comm::(CAN_ID::)?/, "", name)
+        if(name ~ /^(Pack_|Unpack_|EncodeExtID|Decode(Priority|Source|Param|Group|Message)|CAN::GenericMessage::Calculate)/)
+            printf "{\"function\":\"%s\",\"size\":%d}\n", name, $2
+    }'
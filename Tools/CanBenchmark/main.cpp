@@ -0,0 +1,42 @@
+#include "CanBenchmark.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace SBT::System::Comm;
+
+namespace {
+struct SteadyTimer {
+    static uint32_t Now()
+    {
+        return static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+
+    static void Enter() {}
+    static void Exit() {}
+
+    static const char* Unit() { return "ns"; }
+};
+} // namespace
+
+// Usage: sbt-can-benchmark [iterations]
+// Prints one JSON line per case to stdout, see CanBenchmark.hpp
+int main(int argc, char* argv[])
+{
+    uint32_t iterations = 100'000;
+    if(argc > 1)
+        iterations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 0));
+
+    Benchmark::Run<SteadyTimer>(iterations,
+                                [](const Benchmark::Result& result) {
+                                    char line[128];
+                                    if(Benchmark::Format(line, sizeof(line),
+                                                         result) > 0)
+                                        std::fputs(line, stdout);
+                                });
+    return 0;
+}
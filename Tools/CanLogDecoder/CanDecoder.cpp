@@ -0,0 +1,250 @@
+#include "CanDecoder.hpp"
+#include "CanCatalog.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace SBT::Tools {
+
+using namespace SBT::System::Comm;
+using namespace SBT::System::Comm::CAN_ID;
+
+// Columns filled by the decoder itself, before the signals of the message
+static constexpr size_t commonColumnCount = 4;
+static const char* const commonColumns[commonColumnCount] = {
+    "timestamp_us", "source", "priority", "snapshot"};
+
+// Decodes signals of frames batch.payload[idx[0..n)] into columns. Column c
+// starts at columns[c * n].
+using DecodeFunction = void (*)(const FrameBatch& batch, const uint32_t* idx,
+                                size_t n, int64_t* columns);
+
+struct MessageInfo {
+    const char* name;
+    const char* const* signals;
+    size_t signalCount;
+    DecodeFunction decode;
+};
+
+// Frames without known Param keep the raw ID and payload
+static const char* const rawSignals[] = {"extID", "payload"};
+
+static void DecodeRaw(const FrameBatch& batch, const uint32_t* idx, size_t n,
+                      int64_t* columns)
+{
+    for(size_t i = 0; i < n; i++) {
+        uint64_t payload;
+        memcpy(&payload, batch.payload[idx[i]], sizeof(payload));
+        columns[i] = batch.extID[idx[i]];
+        columns[n + i] = static_cast<int64_t>(payload);
+    }
+}
+
+#define SBT_DECODER_SIGNAL_NAME(SIGNAL) #SIGNAL,
+#define SBT_DECODER_SIGNAL_STORE(SIGNAL)                                       \
+    columns[(c++) * n + i] = static_cast<int64_t>(m.SIGNAL);
+
+// For every message in the catalog create the list of signal names and a
+// function unpacking a whole group of frames with the generated Unpack_*
+#define SBT_DECODER_MESSAGE(NAME)                                              \
+    static const char* const signals_##NAME[] = {                              \
+        SBT_CAN_SIGNALS_##NAME(SBT_DECODER_SIGNAL_NAME)};                      \
+    static void Decode_##NAME(const FrameBatch& batch, const uint32_t* idx,    \
+                              size_t n, int64_t* columns)                      \
+    {                                                                          \
+        for(size_t i = 0; i < n; i++) {                                        \
+            const NAME##_t m = Unpack_##NAME(batch.payload[idx[i]]);           \
+            size_t c = 0;                                                      \
+            SBT_CAN_SIGNALS_##NAME(SBT_DECODER_SIGNAL_STORE)                   \
+        }                                                                      \
+    }
+
+SBT_CAN_CATALOG(SBT_DECODER_MESSAGE)
+
+// Message descriptions indexed by Param value
+static const std::array<MessageInfo, Decoder::paramCount> messages = []() {
+    std::array<MessageInfo, Decoder::paramCount> table{};
+    table[static_cast<size_t>(Param::DEFAULT)] = {
+        "DEFAULT", rawSignals, std::size(rawSignals), DecodeRaw};
+    table[static_cast<size_t>(Param::UNKNOWN)] = {
+        "UNKNOWN", rawSignals, std::size(rawSignals), DecodeRaw};
+
+#define SBT_DECODER_TABLE_ENTRY(NAME)                                          \
+    table[static_cast<size_t>(Param::NAME)] = {                                \
+        #NAME, signals_##NAME, std::size(signals_##NAME), Decode_##NAME};
+    SBT_CAN_CATALOG(SBT_DECODER_TABLE_ENTRY)
+#undef SBT_DECODER_TABLE_ENTRY
+
+    return table;
+}();
+
+class Decoder::Output {
+public:
+    Output(const std::string& path, const MessageInfo& info,
+           OutputFormat format)
+        : file(std::fopen(path.c_str(), "wb")), format(format)
+    {
+        if(file == nullptr)
+            throw std::runtime_error("Could not create " + path);
+
+        if(format == OutputFormat::CSV) {
+            for(const auto* name : commonColumns) {
+                buffer += name;
+                buffer += ',';
+            }
+            for(size_t c = 0; c < info.signalCount; c++) {
+                buffer += info.signals[c];
+                buffer += c + 1 < info.signalCount ? ',' : '\n';
+            }
+        }
+        else {
+            const uint16_t version = 1;
+            const auto columnCount =
+                static_cast<uint16_t>(commonColumnCount + info.signalCount);
+            buffer.append("SBTC", 4);
+            Append(&version, sizeof(version));
+            Append(&columnCount, sizeof(columnCount));
+
+            const auto appendName = [this](const char* name) {
+                const auto length = static_cast<uint16_t>(strlen(name));
+                Append(&length, sizeof(length));
+                buffer.append(name, length);
+            };
+            for(const auto* name : commonColumns)
+                appendName(name);
+            for(size_t c = 0; c < info.signalCount; c++)
+                appendName(info.signals[c]);
+        }
+    }
+
+    ~Output()
+    {
+        Flush();
+        std::fclose(file);
+    }
+
+    Output(const Output&) = delete;
+    Output& operator=(const Output&) = delete;
+
+    // Append rows stored column-wise: column c starts at columns[c * rows]
+    void Write(const int64_t* columns, size_t columnCount, size_t rows)
+    {
+        if(format == OutputFormat::Columnar) {
+            const auto rowCount = static_cast<uint32_t>(rows);
+            Append(&rowCount, sizeof(rowCount));
+            Append(columns, columnCount * rows * sizeof(int64_t));
+        }
+        else {
+            // Longest int64_t in decimal is 20 characters plus separator
+            char line[24 * 32];
+            for(size_t r = 0; r < rows; r++) {
+                char* p = line;
+                for(size_t c = 0; c < columnCount; c++) {
+                    p = std::to_chars(p, line + sizeof(line) - 1,
+                                      columns[c * rows + r])
+                            .ptr;
+                    *p++ = c + 1 < columnCount ? ',' : '\n';
+                }
+                buffer.append(line, static_cast<size_t>(p - line));
+            }
+        }
+
+        if(buffer.size() >= flushThreshold)
+            Flush();
+    }
+
+    void Flush()
+    {
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+
+private:
+    static constexpr size_t flushThreshold = 1 << 20;
+
+    void Append(const void* data, size_t size)
+    {
+        buffer.append(static_cast<const char*>(data), size);
+    }
+
+    std::FILE* const file;
+    const OutputFormat format;
+    std::string buffer;
+};
+
+Decoder::Decoder(std::string outputDirectory, OutputFormat outputFormat)
+    : outputDirectory(std::move(outputDirectory)), outputFormat(outputFormat)
+{
+}
+
+Decoder::~Decoder() = default;
+
+const char* Decoder::GetMessageName(size_t param)
+{
+    return param < paramCount ? messages[param].name : "UNKNOWN";
+}
+
+Decoder::Output& Decoder::GetOutput(size_t param)
+{
+    if(!outputs[param]) {
+        const auto& info = messages[param];
+        const char* extension =
+            outputFormat == OutputFormat::CSV ? ".csv" : ".sbtc";
+        outputs[param] = std::make_unique<Output>(
+            outputDirectory + "/" + info.name + extension, info, outputFormat);
+    }
+    return *outputs[param];
+}
+
+void Decoder::Decode(FrameBatch& batch)
+{
+    SplitIDs(batch);
+
+    // Counting sort of frame indices by Param, so every message type is
+    // decoded in one tight loop
+    std::array<uint32_t, paramCount + 1> start{};
+    for(size_t i = 0; i < batch.size; i++)
+        start[batch.param[i] + 1]++;
+    for(size_t p = 0; p < paramCount; p++)
+        start[p + 1] += start[p];
+
+    auto position = start;
+    for(size_t i = 0; i < batch.size; i++)
+        order[position[batch.param[i]]++] = static_cast<uint32_t>(i);
+
+    for(size_t p = 0; p < paramCount; p++) {
+        const size_t n = start[p + 1] - start[p];
+        if(n == 0)
+            continue;
+
+        const auto& info = messages[p];
+        const uint32_t* idx = &order[start[p]];
+        const size_t columnCount = commonColumnCount + info.signalCount;
+
+        columns.resize(columnCount * n);
+        int64_t* data = columns.data();
+        for(size_t i = 0; i < n; i++) {
+            data[i] = static_cast<int64_t>(batch.timestamp[idx[i]]);
+            data[n + i] = batch.source[idx[i]];
+            data[2 * n + i] = batch.priority[idx[i]];
+            data[3 * n + i] = batch.snapshot[idx[i]];
+        }
+        info.decode(batch, idx, n, data + commonColumnCount * n);
+
+        GetOutput(p).Write(data, columnCount, n);
+        stats.perParam[p] += n;
+    }
+
+    stats.frames += batch.size;
+}
+
+void Decoder::Flush()
+{
+    for(auto& output : outputs)
+        if(output)
+            output->Flush();
+}
+
+} // namespace SBT::Tools
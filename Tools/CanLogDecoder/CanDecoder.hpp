@@ -0,0 +1,95 @@
+#ifndef SBT_TOOLS_CANDECODER_HPP
+#define SBT_TOOLS_CANDECODER_HPP
+
+#include "CanID_autogenerated.hpp"
+#include "CanLog.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Decoder turns batches of raw frames into one signal table per message type.
+// Every table gets columns: timestamp_us, source, priority, snapshot (the
+// counter shared by frames of one multi-frame snapshot, 0 for ordinary
+// messages) and then all signals of the message (raw values, as returned by
+// the generated Unpack_* function).
+// Frames with Param DEFAULT or UNKNOWN are written to DEFAULT/UNKNOWN tables
+// holding the raw extID and the payload (as a little-endian 64-bit number).
+//
+// Output formats, one file per message type in the output directory:
+// - CSV:      <MESSAGE>.csv with a header line
+// - Columnar: <MESSAGE>.sbtc, an Arrow-like layout made of record batches:
+//   uint8_t magic[4] = "SBTC", uint16_t version = 1, uint16_t columnCount,
+//   then for every column: uint16_t nameLength, char name[nameLength],
+//   then record batches until the end of file: uint32_t rowCount followed by
+//   columnCount arrays of rowCount int64_t values.
+//   All values are little-endian.
+
+namespace SBT::Tools {
+
+class Decoder {
+public:
+    enum class OutputFormat {
+        CSV,
+        Columnar
+    };
+
+    // One slot per Param value, including DEFAULT and UNKNOWN
+    static constexpr size_t paramCount =
+        static_cast<size_t>(SBT::System::Comm::CAN_ID::Param::UNKNOWN) + 1;
+
+    struct Statistics {
+        uint64_t frames = 0;
+        std::array<uint64_t, paramCount> perParam{};
+    };
+
+    /**
+     * @brief Create decoder writing to existing directory
+     * @param outputDirectory directory where output files will be created
+     * @param outputFormat CSV or Columnar
+     */
+    Decoder(std::string outputDirectory, OutputFormat outputFormat);
+    ~Decoder();
+
+    Decoder(const Decoder&) = delete;
+    Decoder& operator=(const Decoder&) = delete;
+
+    /**
+     * @brief Decode all frames of the batch and append them to output files.
+     * Calls SplitIDs() on the batch.
+     */
+    void Decode(FrameBatch& batch);
+
+    /**
+     * @brief Write buffered data to output files
+     */
+    void Flush();
+
+    [[nodiscard]] const Statistics& GetStatistics() const { return stats; }
+
+    /**
+     * @brief Name of the message (table) for given Param value
+     */
+    static const char* GetMessageName(size_t param);
+
+private:
+    class Output;
+
+    Output& GetOutput(size_t param);
+
+    const std::string outputDirectory;
+    const OutputFormat outputFormat;
+    std::array<std::unique_ptr<Output>, paramCount> outputs;
+    Statistics stats;
+
+    // Frame indices sorted by Param, reused between batches
+    std::array<uint32_t, FrameBatch::capacity> order{};
+    // Decoded columns of one message type, reused between batches
+    std::vector<int64_t> columns;
+};
+
+} // namespace SBT::Tools
+
+#endif // SBT_TOOLS_CANDECODER_HPP
@@ -0,0 +1,266 @@
+#include "CanLog.hpp"
+#include "CanIDCodec.hpp"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SBT::Tools {
+
+using namespace SBT::System::Comm::CAN_ID;
+
+static constexpr char binaryMagic[8] = {'S', 'B', 'T', 'C', 'A', 'N', 'L', 'G'};
+static constexpr uint32_t binaryVersion = 1;
+static constexpr size_t binaryHeaderSize = 16;
+static constexpr size_t binaryRecordSize = 24;
+
+// SocketCAN flags stored in the upper bits of the CAN ID
+static constexpr uint32_t canEffFlag = 0x80000000U;
+static constexpr uint32_t canRtrFlag = 0x40000000U;
+static constexpr uint32_t canErrFlag = 0x20000000U;
+static constexpr uint32_t canEffMask = 0x1FFFFFFFU;
+
+// Lookup table for hex digits, 0xFF marks an invalid character
+static constexpr std::array<uint8_t, 256> hexTable = []() {
+    std::array<uint8_t, 256> table{};
+    for(auto& entry : table)
+        entry = 0xFF;
+    for(uint8_t i = 0; i < 10; i++)
+        table['0' + i] = i;
+    for(uint8_t i = 0; i < 6; i++) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+    return table;
+}();
+
+void SplitIDs(FrameBatch& batch)
+{
+    // Plain loop over arrays without early exits, so the compiler can
+    // vectorize it
+    for(size_t i = 0; i < batch.size; i++) {
+        const uint32_t id = batch.extID[i];
+        batch.priority[i] = DecodePriority(id);
+        batch.source[i] = static_cast<uint8_t>(DecodeSource(id));
+        batch.param[i] = static_cast<uint16_t>(DecodeParam(id));
+        batch.snapshot[i] = DecodeSnapshot(id);
+        batch.group[i] = static_cast<uint8_t>(DecodeGroup(id));
+    }
+}
+
+LogReader::LogReader(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw std::runtime_error("Could not open " + path);
+
+    struct stat st {};
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not stat " + path);
+    }
+    fileSize = static_cast<size_t>(st.st_size);
+
+    if(fileSize > 0) {
+        void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Could not map " + path);
+        }
+        madvise(mapping, fileSize, MADV_SEQUENTIAL | MADV_WILLNEED);
+        data = static_cast<const char*>(mapping);
+    }
+    // The mapping stays valid after closing the descriptor
+    close(fd);
+
+    if(fileSize >= binaryHeaderSize &&
+       memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0) {
+        uint32_t version;
+        memcpy(&version, data + sizeof(binaryMagic), sizeof(version));
+        if(version != binaryVersion)
+            throw std::runtime_error("Unsupported binary log version in " +
+                                     path);
+        format = Format::Binary;
+        offset = binaryHeaderSize;
+    }
+}
+
+LogReader::~LogReader()
+{
+    if(data != nullptr)
+        munmap(const_cast<char*>(data), fileSize);
+}
+
+size_t LogReader::Read(FrameBatch& batch)
+{
+    batch.size = 0;
+    if(format == Format::Binary)
+        return ReadBinary(batch);
+    return ReadCandump(batch);
+}
+
+size_t LogReader::ReadBinary(FrameBatch& batch)
+{
+    while(batch.size < FrameBatch::capacity &&
+          offset + binaryRecordSize <= fileSize) {
+        const char* record = data + offset;
+        offset += binaryRecordSize;
+
+        uint32_t canID;
+        memcpy(&canID, record + 8, sizeof(canID));
+        // Only extended data frames are decoded, SBT IDs are 29-bit
+        if((canID & canEffFlag) == 0 || (canID & (canErrFlag | canRtrFlag))) {
+            skipped++;
+            continue;
+        }
+
+        const size_t i = batch.size++;
+        memcpy(&batch.timestamp[i], record, sizeof(uint64_t));
+        batch.extID[i] = canID & canEffMask;
+        memcpy(batch.payload[i], record + 16, 8);
+    }
+
+    // Trailing partial record
+    if(batch.size == 0 && offset < fileSize) {
+        skipped++;
+        offset = fileSize;
+    }
+
+    return batch.size;
+}
+
+// Parse one candump log line: (seconds.fraction) interface ID#DATA
+// Returns false if the line does not describe a classic extended data frame.
+static bool ParseCandumpLine(const char* p, const char* end,
+                             uint64_t& timestamp, uint32_t& id,
+                             uint8_t (&payload)[8])
+{
+    if(p == end || *p != '(')
+        return false;
+    p++;
+
+    // Timestamp
+    uint64_t seconds = 0;
+    while(p < end && hexTable[static_cast<uint8_t>(*p)] < 10)
+        seconds = seconds * 10 + (*p++ - '0');
+    if(p == end || *p != '.')
+        return false;
+    p++;
+
+    uint64_t fraction = 0;
+    unsigned digits = 0;
+    while(p < end && hexTable[static_cast<uint8_t>(*p)] < 10) {
+        if(digits < 6) {
+            fraction = fraction * 10 + (*p - '0');
+            digits++;
+        }
+        p++;
+    }
+    for(; digits < 6; digits++)
+        fraction *= 10;
+    if(p == end || *p != ')')
+        return false;
+    timestamp = seconds * 1'000'000 + fraction;
+    p++;
+
+    // Interface name
+    while(p < end && *p == ' ')
+        p++;
+    while(p < end && *p != ' ')
+        p++;
+    while(p < end && *p == ' ')
+        p++;
+
+    // CAN ID
+    id = 0;
+    const char* idStart = p;
+    uint8_t nibble;
+    while(p < end && (nibble = hexTable[static_cast<uint8_t>(*p)]) != 0xFF) {
+        id = (id << 4) | nibble;
+        p++;
+    }
+    if(p == idStart || p == end || *p != '#')
+        return false;
+    // candump writes standard (11-bit) IDs with 3 digits, extended with 8.
+    // Standard frames are not SBT frames.
+    if(p - idStart != 8)
+        return false;
+    p++;
+
+    // '##' marks a CAN FD frame, 'R' a remote frame
+    if(p < end && (*p == '#' || *p == 'R'))
+        return false;
+
+    memset(payload, 0, 8);
+    for(unsigned i = 0; i < 8 && p + 1 < end; i++) {
+        const uint8_t high = hexTable[static_cast<uint8_t>(p[0])];
+        const uint8_t low = hexTable[static_cast<uint8_t>(p[1])];
+        if((high | low) == 0xFF)
+            break;
+        payload[i] = static_cast<uint8_t>((high << 4) | low);
+        p += 2;
+    }
+
+    id &= canEffMask;
+    return true;
+}
+
+size_t LogReader::ReadCandump(FrameBatch& batch)
+{
+    while(batch.size < FrameBatch::capacity && offset < fileSize) {
+        const char* line = data + offset;
+        const char* eol = static_cast<const char*>(
+            memchr(line, '\n', fileSize - offset));
+        const char* end = eol != nullptr ? eol : data + fileSize;
+        offset = static_cast<size_t>(end - data) + 1;
+
+        if(end > line && end[-1] == '\r')
+            end--;
+        if(end == line)
+            continue;
+
+        const size_t i = batch.size;
+        if(ParseCandumpLine(line, end, batch.timestamp[i], batch.extID[i],
+                            batch.payload[i]))
+            batch.size++;
+        else
+            skipped++;
+    }
+
+    return batch.size;
+}
+
+BinaryLogWriter::BinaryLogWriter(const std::string& path)
+    : file(std::fopen(path.c_str(), "wb"))
+{
+    if(file == nullptr)
+        throw std::runtime_error("Could not create " + path);
+
+    char header[binaryHeaderSize]{};
+    memcpy(header, binaryMagic, sizeof(binaryMagic));
+    memcpy(header + sizeof(binaryMagic), &binaryVersion,
+           sizeof(binaryVersion));
+    std::fwrite(header, 1, sizeof(header), file);
+}
+
+BinaryLogWriter::~BinaryLogWriter() { std::fclose(file); }
+
+void BinaryLogWriter::Write(const FrameBatch& batch)
+{
+    char record[binaryRecordSize]{};
+    for(size_t i = 0; i < batch.size; i++) {
+        const uint32_t canID = batch.extID[i] | canEffFlag;
+        memcpy(record, &batch.timestamp[i], sizeof(uint64_t));
+        memcpy(record + 8, &canID, sizeof(canID));
+        record[12] = 8;
+        memcpy(record + 16, batch.payload[i], 8);
+        std::fwrite(record, 1, sizeof(record), file);
+    }
+}
+
+} // namespace SBT::Tools
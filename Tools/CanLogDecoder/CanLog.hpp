@@ -0,0 +1,121 @@
+#ifndef SBT_TOOLS_CANLOG_HPP
+#define SBT_TOOLS_CANLOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// How to use this library:
+// 1. Open a log file with LogReader. The format (candump or binary) is
+// detected from the file content.
+// 2. Read frames in batches with LogReader::Read() until it returns 0.
+// 3. Pass every batch to a Decoder (see CanDecoder.hpp).
+//
+// Supported formats:
+// - candump log, as written by `candump -l` / `candump -L`:
+//   (1436509052.249713) can0 0CA12345#0102030405060708
+//   Frames with standard IDs (3 digits, e.g. 123#01) are skipped.
+// - SBT binary log: a 16-byte header followed by fixed 24-byte records.
+//   Header: char magic[8] = "SBTCANLG", uint32_t version = 1, uint32_t 0
+//   Record: uint64_t timestamp_us, uint32_t canID (SocketCAN flags in bits
+//   29..31), uint8_t dlc, uint8_t pad[3], uint8_t data[8]. Records without
+//   the extended frame flag are skipped.
+//   All values are little-endian.
+
+namespace SBT::Tools {
+
+/**
+ * @brief Batch of CAN frames stored column-wise, so that ID splitting and
+ * signal decoding run as tight loops over plain arrays.
+ */
+struct FrameBatch {
+    static constexpr size_t capacity = 4096;
+
+    size_t size = 0;
+
+    // Filled by LogReader
+    uint64_t timestamp[capacity]; // microseconds
+    uint32_t extID[capacity];
+    uint8_t payload[capacity][8];
+
+    // Filled by SplitIDs()
+    uint8_t priority[capacity];
+    uint8_t source[capacity];
+    uint16_t param[capacity];
+    uint8_t snapshot[capacity];
+    uint8_t group[capacity];
+};
+
+/**
+ * @brief Split raw extended IDs of the whole batch into priority, Source,
+ * Param, snapshot counter and Group - the same way CAN::RxMessage getters do.
+ * Out-of-range values are mapped to UNKNOWN.
+ */
+void SplitIDs(FrameBatch& batch);
+
+class LogReader {
+public:
+    enum class Format {
+        Candump,
+        Binary
+    };
+
+    /**
+     * @brief Memory-map a log file. Throws std::runtime_error on failure.
+     * @param path path to the log file
+     */
+    explicit LogReader(const std::string& path);
+    ~LogReader();
+
+    LogReader(const LogReader&) = delete;
+    LogReader& operator=(const LogReader&) = delete;
+
+    /**
+     * @brief Read next frames into the batch (overwrites its content)
+     * @return number of frames read, 0 at the end of the file
+     */
+    size_t Read(FrameBatch& batch);
+
+    [[nodiscard]] Format GetFormat() const { return format; }
+    /**
+     * @brief Number of lines or records which could not be parsed or are
+     * not SBT frames - standard (11-bit) IDs, remote and error frames
+     */
+    [[nodiscard]] uint64_t GetSkippedCount() const { return skipped; }
+    /**
+     * @brief Size of the mapped file in bytes
+     */
+    [[nodiscard]] size_t GetFileSize() const { return fileSize; }
+
+private:
+    size_t ReadCandump(FrameBatch& batch);
+    size_t ReadBinary(FrameBatch& batch);
+
+    const char* data = nullptr;
+    size_t fileSize = 0;
+    size_t offset = 0;
+    Format format = Format::Candump;
+    uint64_t skipped = 0;
+};
+
+/**
+ * @brief Writes frames in the SBT binary log format
+ */
+class BinaryLogWriter {
+public:
+    explicit BinaryLogWriter(const std::string& path);
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    void Write(const FrameBatch& batch);
+
+private:
+    std::FILE* file;
+};
+
+} // namespace SBT::Tools
+
+#endif // SBT_TOOLS_CANLOG_HPP
@@ -0,0 +1,134 @@
+#include "CanDecoder.hpp"
+#include "CanLog.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace SBT::Tools;
+
+static void PrintUsage(const char* program)
+{
+    std::fprintf(
+        stderr,
+        "Usage: %s [options] LOG...\n"
+        "Decode candump or SBT binary CAN logs into one table per message.\n"
+        "\n"
+        "Options:\n"
+        "  --output csv|sbtc   output format (default: csv)\n"
+        "  --out-dir DIR       existing output directory (default: .)\n"
+        "  --to-binary FILE    convert logs to the SBT binary log format\n"
+        "                      instead of decoding them\n"
+        "  --stats             print per-message counts and throughput\n",
+        program);
+}
+
+int main(int argc, char* argv[])
+{
+    auto format = Decoder::OutputFormat::CSV;
+    std::string outputDirectory = ".";
+    std::string binaryPath;
+    bool printStatistics = false;
+    std::vector<std::string> inputs;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if(strcmp(arg, "--output") == 0 && hasValue) {
+            const char* value = argv[++i];
+            if(strcmp(value, "csv") == 0)
+                format = Decoder::OutputFormat::CSV;
+            else if(strcmp(value, "sbtc") == 0)
+                format = Decoder::OutputFormat::Columnar;
+            else {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if(strcmp(arg, "--out-dir") == 0 && hasValue)
+            outputDirectory = argv[++i];
+        else if(strcmp(arg, "--to-binary") == 0 && hasValue)
+            binaryPath = argv[++i];
+        else if(strcmp(arg, "--stats") == 0)
+            printStatistics = true;
+        else if(arg[0] == '-') {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        else
+            inputs.emplace_back(arg);
+    }
+
+    if(inputs.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        // FrameBatch is too large for the stack
+        auto batch = std::make_unique<FrameBatch>();
+        std::unique_ptr<Decoder> decoder;
+        std::unique_ptr<BinaryLogWriter> writer;
+        if(binaryPath.empty())
+            decoder = std::make_unique<Decoder>(outputDirectory, format);
+        else
+            writer = std::make_unique<BinaryLogWriter>(binaryPath);
+
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+        uint64_t skipped = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        for(const auto& input : inputs) {
+            LogReader reader(input);
+            while(reader.Read(*batch) > 0) {
+                frames += batch->size;
+                if(decoder)
+                    decoder->Decode(*batch);
+                else
+                    writer->Write(*batch);
+            }
+            bytes += reader.GetFileSize();
+            skipped += reader.GetSkippedCount();
+        }
+        if(decoder)
+            decoder->Flush();
+
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        if(skipped > 0)
+            std::fprintf(stderr, "Skipped %llu lines/records\n",
+                         static_cast<unsigned long long>(skipped));
+
+        if(printStatistics) {
+            if(decoder) {
+                const auto& stats = decoder->GetStatistics();
+                for(size_t p = 0; p < Decoder::paramCount; p++)
+                    if(stats.perParam[p] > 0)
+                        std::fprintf(
+                            stderr, "%-24s %12llu\n",
+                            Decoder::GetMessageName(p),
+                            static_cast<unsigned long long>(stats.perParam[p]));
+            }
+
+            const double seconds = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+            std::fprintf(stderr,
+                         "%llu frames in %.3f s: %.0f frames/s, %.1f MB/s\n",
+                         static_cast<unsigned long long>(frames), seconds,
+                         static_cast<double>(frames) / seconds,
+                         static_cast<double>(bytes) / seconds / 1e6);
+        }
+    }
+    catch(const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}